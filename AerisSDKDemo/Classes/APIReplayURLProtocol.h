@@ -0,0 +1,46 @@
+//
+//  APIReplayURLProtocol.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `APIReplayURLProtocol` records the Aeris API responses received by the app to a directory and can later serve them back
+ *  in place of the network, so the loader, parsing and mapping pipeline can be exercised and timed without a connection
+ *  and with the same data every run.
+ *
+ *  Responses are stored by request URL with the client credentials removed and the query parameters sorted, so a recording
+ *  made with one set of credentials can be replayed with another. Requests without a recorded response fail with an
+ *  `NSURLErrorNotConnectedToInternet` error while replaying.
+ */
+@interface APIReplayURLProtocol : NSURLProtocol
+
+/**
+ *  Registers the protocol and starts recording API responses to the directory, which is created if needed.
+ */
++ (void)startRecordingToDirectory:(NSString *)path;
+
+/**
+ *  Registers the protocol and starts serving API responses from a directory previously recorded to.
+ */
++ (void)startReplayingFromDirectory:(NSString *)path;
+
+/**
+ *  Stops recording or replaying and unregisters the protocol.
+ */
++ (void)stop;
+
+/**
+ *  The number of times the results of each replayed response are repeated, for generating payloads much larger than the
+ *  recorded ones, such as thousands of lightning strikes or hundreds of advisories from a recording of a few. Each result
+ *  in a list response is repeated, including within each response of a batch request, while single object responses are
+ *  served unchanged. Defaults to `1`.
+ */
++ (NSUInteger)responseScale;
++ (void)setResponseScale:(NSUInteger)scale;
+
+@end
@@ -0,0 +1,257 @@
+//
+//  APIReplayURLProtocol.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "APIReplayURLProtocol.h"
+
+typedef NS_ENUM (NSInteger, APIReplayMode) {
+	APIReplayModeOff = 0,
+	APIReplayModeRecording,
+	APIReplayModeReplaying
+};
+
+@interface APIReplayURLProtocol () <NSURLConnectionDataDelegate>
+@property (nonatomic, strong) NSURLConnection *connection;
+@property (nonatomic, strong) NSHTTPURLResponse *response;
+@property (nonatomic, strong) NSMutableData *data;
++ (NSString *)filePathForRequest:(NSURLRequest *)request;
++ (NSData *)bodyByScalingBody:(NSData *)body;
++ (id)responseByScalingResponse:(id)response scale:(NSUInteger)scale;
+- (void)replayResponse;
+@end
+
+static NSString *handledPropertyKey = @"APIReplayURLProtocolHandled";
+
+static NSString *responseStatusCodeKey	= @"status";
+static NSString *responseHeadersKey		= @"headers";
+static NSString *responseBodyKey		= @"body";
+
+static NSString *apiResponseKey			= @"response";
+static NSString *apiBatchResponsesKey	= @"responses";
+
+static APIReplayMode currentMode = APIReplayModeOff;
+static NSString *currentDirectoryPath = nil;
+static NSUInteger currentResponseScale = 1;
+
+@implementation APIReplayURLProtocol
+
++ (void)startRecordingToDirectory:(NSString *)path {
+	[[NSFileManager defaultManager] createDirectoryAtPath:path withIntermediateDirectories:YES attributes:nil error:nil];
+
+	@synchronized(self) {
+		currentDirectoryPath = [path copy];
+		currentMode = APIReplayModeRecording;
+	}
+	[NSURLProtocol registerClass:self];
+}
+
++ (void)startReplayingFromDirectory:(NSString *)path {
+	@synchronized(self) {
+		currentDirectoryPath = [path copy];
+		currentMode = APIReplayModeReplaying;
+	}
+	[NSURLProtocol registerClass:self];
+}
+
++ (void)stop {
+	[NSURLProtocol unregisterClass:self];
+
+	@synchronized(self) {
+		currentDirectoryPath = nil;
+		currentMode = APIReplayModeOff;
+	}
+}
+
++ (NSUInteger)responseScale {
+	@synchronized(self) {
+		return currentResponseScale;
+	}
+}
+
++ (void)setResponseScale:(NSUInteger)scale {
+	@synchronized(self) {
+		currentResponseScale = MAX(scale, 1);
+	}
+}
+
+#pragma mark - NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+	@synchronized(self) {
+		if (currentMode == APIReplayModeOff) {
+			return NO;
+		}
+	}
+
+	// skip the pass-through requests made while recording
+	if ([NSURLProtocol propertyForKey:handledPropertyKey inRequest:request]) {
+		return NO;
+	}
+
+	return ([[request.HTTPMethod uppercaseString] isEqualToString:@"GET"] && [[request.URL.host lowercaseString] hasSuffix:@"aerisapi.com"]);
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+	return request;
+}
+
+- (void)startLoading {
+	APIReplayMode mode;
+	@synchronized([self class]) {
+		mode = currentMode;
+	}
+
+	if (mode == APIReplayModeReplaying) {
+		[self replayResponse];
+		return;
+	}
+
+	NSMutableURLRequest *request = [self.request mutableCopy];
+	[NSURLProtocol setProperty:@YES forKey:handledPropertyKey inRequest:request];
+
+	self.data = [[NSMutableData alloc] init];
+	self.connection = [NSURLConnection connectionWithRequest:request delegate:self];
+}
+
+- (void)stopLoading {
+	[self.connection cancel];
+	self.connection = nil;
+}
+
+#pragma mark - NSURLConnectionDataDelegate
+
+- (void)connection:(NSURLConnection *)connection didReceiveResponse:(NSURLResponse *)response {
+	self.response = ([response isKindOfClass:[NSHTTPURLResponse class]]) ? (NSHTTPURLResponse *)response : nil;
+	[self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+}
+
+- (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data {
+	[self.data appendData:data];
+	[self.client URLProtocol:self didLoadData:data];
+}
+
+- (void)connectionDidFinishLoading:(NSURLConnection *)connection {
+	NSString *filePath = [[self class] filePathForRequest:self.request];
+	if (filePath && self.response) {
+		// the body has already been decoded, so the original encoding and length no longer apply to it
+		NSMutableDictionary *headers = [NSMutableDictionary dictionaryWithDictionary:self.response.allHeaderFields];
+		[headers removeObjectForKey:@"Content-Encoding"];
+		[headers removeObjectForKey:@"Content-Length"];
+
+		NSDictionary *recording = @{responseStatusCodeKey: @(self.response.statusCode),
+									responseHeadersKey: headers,
+									responseBodyKey: self.data};
+		[recording writeToFile:filePath atomically:YES];
+	}
+
+	[self.client URLProtocolDidFinishLoading:self];
+	self.connection = nil;
+}
+
+- (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error {
+	[self.client URLProtocol:self didFailWithError:error];
+	self.connection = nil;
+}
+
+#pragma mark - Private
+
++ (NSString *)filePathForRequest:(NSURLRequest *)request {
+	NSString *directoryPath = nil;
+	@synchronized(self) {
+		directoryPath = currentDirectoryPath;
+	}
+	if (!directoryPath) {
+		return nil;
+	}
+
+	// leave out the credentials and sort the remaining parameters so the same request always maps to the same file
+	NSMutableArray *components = [[NSMutableArray alloc] init];
+	[[request.URL.query componentsSeparatedByString:@"&"] enumerateObjectsUsingBlock:^(NSString *component, NSUInteger idx, BOOL *stop) {
+		if ([component length] > 0 && ![component hasPrefix:@"client_id="] && ![component hasPrefix:@"client_secret="]) {
+			[components addObject:component];
+		}
+	}];
+	[components sortUsingSelector:@selector(compare:)];
+
+	NSString *key = [NSString stringWithFormat:@"%@?%@", request.URL.path, [components componentsJoinedByString:@"&"]];
+	NSString *fileName = [AWFDemoSHA1String([key dataUsingEncoding:NSUTF8StringEncoding]) stringByAppendingPathExtension:@"plist"];
+
+	return [directoryPath stringByAppendingPathComponent:fileName];
+}
+
++ (NSData *)bodyByScalingBody:(NSData *)body {
+	NSUInteger scale = [self responseScale];
+	if (scale <= 1 || !body) {
+		return body;
+	}
+
+	NSDictionary *json = [NSJSONSerialization JSONObjectWithData:body options:0 error:NULL];
+	if (![json isKindOfClass:[NSDictionary class]] || ![json objectForKey:apiResponseKey]) {
+		return body;
+	}
+
+	NSMutableDictionary *scaledJSON = [json mutableCopy];
+	[scaledJSON setObject:[self responseByScalingResponse:[json objectForKey:apiResponseKey] scale:scale] forKey:apiResponseKey];
+
+	NSData *scaledBody = [NSJSONSerialization dataWithJSONObject:scaledJSON options:0 error:NULL];
+	return (scaledBody) ? scaledBody : body;
+}
+
++ (id)responseByScalingResponse:(id)response scale:(NSUInteger)scale {
+	// repeat the results of a list response
+	if ([response isKindOfClass:[NSArray class]]) {
+		NSMutableArray *scaledResponse = [NSMutableArray arrayWithCapacity:[response count] * scale];
+		for (NSUInteger i = 0; i < scale; i++) {
+			[scaledResponse addObjectsFromArray:response];
+		}
+		return scaledResponse;
+	}
+
+	// batch responses contain a complete response for each request
+	NSArray *batchResponses = ([response isKindOfClass:[NSDictionary class]]) ? [response objectForKey:apiBatchResponsesKey] : nil;
+	if ([batchResponses isKindOfClass:[NSArray class]]) {
+		NSMutableArray *scaledResponses = [NSMutableArray arrayWithCapacity:[batchResponses count]];
+		[batchResponses enumerateObjectsUsingBlock:^(id batchResponse, NSUInteger idx, BOOL *stop) {
+			if ([batchResponse isKindOfClass:[NSDictionary class]] && [batchResponse objectForKey:apiResponseKey]) {
+				NSMutableDictionary *scaledBatchResponse = [batchResponse mutableCopy];
+				[scaledBatchResponse setObject:[self responseByScalingResponse:[batchResponse objectForKey:apiResponseKey] scale:scale] forKey:apiResponseKey];
+				[scaledResponses addObject:scaledBatchResponse];
+			}
+			else {
+				[scaledResponses addObject:batchResponse];
+			}
+		}];
+
+		NSMutableDictionary *scaledResponse = [response mutableCopy];
+		[scaledResponse setObject:scaledResponses forKey:apiBatchResponsesKey];
+		return scaledResponse;
+	}
+
+	return response;
+}
+
+- (void)replayResponse {
+	NSString *filePath = [[self class] filePathForRequest:self.request];
+	NSDictionary *recording = (filePath) ? [NSDictionary dictionaryWithContentsOfFile:filePath] : nil;
+
+	if (!recording) {
+		NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:@{NSURLErrorFailingURLErrorKey: self.request.URL}];
+		[self.client URLProtocol:self didFailWithError:error];
+		return;
+	}
+
+	NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+															  statusCode:[[recording objectForKey:responseStatusCodeKey] integerValue]
+															 HTTPVersion:@"HTTP/1.1"
+															headerFields:[recording objectForKey:responseHeadersKey]];
+
+	[self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+	[self.client URLProtocol:self didLoadData:[[self class] bodyByScalingBody:[recording objectForKey:responseBodyKey]]];
+	[self.client URLProtocolDidFinishLoading:self];
+}
+
+@end
@@ -9,6 +9,14 @@
 #import "AppDelegate.h"
 #import "CatalogViewController.h"
 #import "DetailedWeatherViewController_iPad.h"
+#import "FieldUsageProfiler.h"
+#import "RequestMetrics.h"
+#import "APIReplayURLProtocol.h"
+#import "PlacePrefetcher.h"
+
+@interface AppDelegate ()
+@property (nonatomic, strong) PlacePrefetcher *prefetcher;
+@end
 
 
 @implementation AppDelegate
@@ -18,8 +26,57 @@
 	
 	
 	
+#ifdef DEBUG
+	// record request timing so a per-endpoint summary can be logged when backgrounded, creating the metrics before the
+	// engine is set up so the summary includes the cold start time until the first objects were delivered
+	[LoaderRequestManager sharedManager].metrics = [[RequestMetrics alloc] init];
+#endif
+	
 	[AerisEngine engineWithKey:@"__CLIENT_ID__" secret:@"__CLIENT_SECRET__"];
+#ifdef DEBUG
+	// the SDK's debug logging formats every message on the loaders' threads, so keep it out of release builds
 	[AerisEngine enableDebug];
+#endif
+	
+	// combine loader requests made within 20ms of each other into a single batch request
+	[LoaderRequestManager sharedManager].batchInterval = 0.02;
+	[LoaderRequestManager sharedManager].coordinateGridSize = 0.01;
+	
+#ifdef DEBUG
+	// record which model properties the app reads so the minimal request fields can be logged when backgrounded
+	[[FieldUsageProfiler sharedProfiler] startProfilingObjectClass:[AWFObservation class]];
+	[[FieldUsageProfiler sharedProfiler] startProfilingObjectClass:[AWFForecast class]];
+	
+	// pass "-APIReplayMode record" or "-APIReplayMode replay" as a launch argument to record API responses or serve the
+	// recorded ones without the network, along with "-APIReplayResponseScale <count>" to repeat the replayed results
+	NSString *replayMode = [[NSUserDefaults standardUserDefaults] stringForKey:@"APIReplayMode"];
+	NSString *recordingsPath = [[NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject] stringByAppendingPathComponent:@"APIRecordings"];
+	if ([replayMode isEqualToString:@"record"]) {
+		[APIReplayURLProtocol startRecordingToDirectory:recordingsPath];
+	}
+	else if ([replayMode isEqualToString:@"replay"]) {
+		[APIReplayURLProtocol setResponseScale:[[NSUserDefaults standardUserDefaults] integerForKey:@"APIReplayResponseScale"]];
+		[APIReplayURLProtocol startReplayingFromDirectory:recordingsPath];
+	}
+#endif
+	
+	// keep the observations and forecasts for the saved locations warm so switching between them is immediate, using the
+	// same options and expiration intervals as the detailed weather view for the device so its requests are served from the
+	// same entries
+	AWFRequestOptions *forecastOptions = [[AWFRequestOptions alloc] init];
+	forecastOptions.limit = (UI_USER_INTERFACE_IDIOM() == UIUserInterfaceIdiomPad) ? 28 : 2;
+	forecastOptions.filterString = @"daynight";
+	
+	AWFRequestOptions *hourlyOptions = [[AWFRequestOptions alloc] init];
+	hourlyOptions.limit = 9;
+	hourlyOptions.filterString = @"3hr";
+	
+	AWFForecastsLoader *forecastsLoader = [[AWFForecastsLoader alloc] init];
+	self.prefetcher = [[PlacePrefetcher alloc] init];
+	[self.prefetcher addLoader:[[AWFObservationsLoader alloc] init] options:nil expirationInterval:300];
+	[self.prefetcher addLoader:forecastsLoader options:forecastOptions expirationInterval:1800];
+	[self.prefetcher addLoader:forecastsLoader options:hourlyOptions expirationInterval:1800];
+	[self.prefetcher start];
 	
 	// must initialize Google Maps SDK with proper API key before using
 	[GMSServices provideAPIKey:@"__GOOGLE_API_KEY__"];
@@ -75,4 +132,14 @@
     return YES;
 }
 
+- (void)applicationDidEnterBackground:(UIApplication *)application {
+#ifdef DEBUG
+	[[FieldUsageProfiler sharedProfiler] logProfiledFields];
+	[[LoaderRequestManager sharedManager].metrics logSummary];
+	
+	NSString *logPath = [[NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject] stringByAppendingPathComponent:@"AppLog.plist"];
+	[[AppLogger sharedLogger] exportRecordsToFile:logPath];
+#endif
+}
+
 @end
@@ -0,0 +1,76 @@
+//
+//  AppLogger.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM (NSInteger, AppLogLevel) {
+	AppLogLevelDebug = 0,
+	AppLogLevelInfo,
+	AppLogLevelWarn,
+	AppLogLevelError
+};
+
+/**
+ *  Logs a message if its level is at or above the shared logger's level. The format and its arguments are only evaluated
+ *  when the message will be logged.
+ */
+#define AppLog(lvl, fmt, ...) do { \
+	if ((lvl) >= [AppLogger sharedLogger].level) { \
+		[[AppLogger sharedLogger] logMessage:[NSString stringWithFormat:(fmt), ##__VA_ARGS__] level:(lvl)]; \
+	} \
+} while (0)
+
+// debug messages are removed entirely from release builds
+#ifdef DEBUG
+#define AppLogDebug(fmt, ...)	AppLog(AppLogLevelDebug, fmt, ##__VA_ARGS__)
+#else
+#define AppLogDebug(fmt, ...)	do {} while (0)
+#endif
+
+#define AppLogInfo(fmt, ...)	AppLog(AppLogLevelInfo, fmt, ##__VA_ARGS__)
+#define AppLogWarn(fmt, ...)	AppLog(AppLogLevelWarn, fmt, ##__VA_ARGS__)
+#define AppLogError(fmt, ...)	AppLog(AppLogLevelError, fmt, ##__VA_ARGS__)
+
+/**
+ *  `AppLogger` writes the demo's log messages to the console from a background queue so that logging doesn't hold up the
+ *  calling thread. The most recent messages are also kept in a fixed-size buffer as records containing their date, level
+ *  and message, which can be exported to a file for attaching to bug reports.
+ *
+ *  Messages should be logged with the `AppLog` macros rather than by calling `logMessage:level:` directly.
+ *
+ *  All methods can be called from any thread.
+ */
+@interface AppLogger : NSObject
+
+/**
+ *  The minimum level of messages that are logged. Defaults to `AppLogLevelDebug` in debug builds and `AppLogLevelWarn`
+ *  otherwise.
+ */
+@property (nonatomic, assign) AppLogLevel level;
+
+/**
+ *  The number of most recent records kept for exporting. Only takes effect until the buffer first fills up, so it should be
+ *  set before logging. Defaults to `1000`.
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
++ (AppLogger *)sharedLogger;
+
+- (void)logMessage:(NSString *)message level:(AppLogLevel)level;
+
+/**
+ *  Writes the buffered records to a file as a binary property list containing an array of dictionaries with `date`,
+ *  `level` and `message` keys, oldest first. Any messages logged before this is called are included.
+ *
+ *  @param path The path of the file to write.
+ *
+ *  @return `YES` if the file was written successfully.
+ */
+- (BOOL)exportRecordsToFile:(NSString *)path;
+
+@end
@@ -0,0 +1,83 @@
+//
+//  AppLogger.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "AppLogger.h"
+
+@interface AppLogger ()
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray *records;
+@property (nonatomic, assign) NSUInteger nextRecordIndex;
+@end
+
+static NSString *recordDateKey		= @"date";
+static NSString *recordLevelKey		= @"level";
+static NSString *recordMessageKey	= @"message";
+
+static NSUInteger defaultCapacity = 1000;
+
+@implementation AppLogger
+
++ (AppLogger *)sharedLogger {
+	static AppLogger *_sharedLogger = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		_sharedLogger = [[AppLogger alloc] init];
+	});
+
+	return _sharedLogger;
+}
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_queue = dispatch_queue_create("com.hamweather.aeriscatalog.applogger", DISPATCH_QUEUE_SERIAL);
+		_records = [[NSMutableArray alloc] init];
+		_capacity = defaultCapacity;
+#ifdef DEBUG
+		_level = AppLogLevelDebug;
+#else
+		_level = AppLogLevelWarn;
+#endif
+	}
+	return self;
+}
+
+- (void)logMessage:(NSString *)message level:(AppLogLevel)level {
+	if (!message) {
+		return;
+	}
+
+	NSDictionary *record = @{recordDateKey: [NSDate date], recordLevelKey: @(level), recordMessageKey: message};
+
+	dispatch_async(self.queue, ^{
+		// once full, overwrite the oldest record instead of growing the buffer
+		if ([self.records count] < MAX(self.capacity, 1)) {
+			[self.records addObject:record];
+		}
+		else {
+			[self.records replaceObjectAtIndex:self.nextRecordIndex withObject:record];
+			self.nextRecordIndex = (self.nextRecordIndex + 1) % [self.records count];
+		}
+
+		NSLog(@"%@", message);
+	});
+}
+
+- (BOOL)exportRecordsToFile:(NSString *)path {
+	__block NSArray *records = nil;
+	dispatch_sync(self.queue, ^{
+		// the oldest record is the one that will be overwritten next
+		NSRange olderRange = NSMakeRange(self.nextRecordIndex, [self.records count] - self.nextRecordIndex);
+		records = [[self.records subarrayWithRange:olderRange] arrayByAddingObjectsFromArray:[self.records subarrayWithRange:NSMakeRange(0, self.nextRecordIndex)]];
+	});
+
+	NSData *data = [NSPropertyListSerialization dataWithPropertyList:records format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+	return [data writeToFile:path atomically:YES];
+}
+
+@end
@@ -146,7 +146,7 @@ static NSString *cellIdentifier = @"AFCatalogCell";
 	if (![[UserLocationsManager sharedManager] defaultLocation]) {
 		[AWFPlace getCurrentLocationWithCompletion:^(AWFPlace *place, NSError *error) {
 		    if (error) {
-		        NSLog(@"Failed to get current location! %@", error);
+		        AppLogError(@"Failed to get current location! %@", error);
 
 		        return;
 			}
@@ -158,7 +158,7 @@ static NSString *cellIdentifier = @"AFCatalogCell";
 		    AWFPlacesLoader *placesLoader = [[AWFPlacesLoader alloc] init];
 		    [placesLoader getClosestToPlace:place radius:@"10mi" options:options completion:^(NSArray *objects, NSError *error) {
 		        if (error) {
-		            NSLog(@"Failed to get place from current location! %@", error);
+		            AppLogError(@"Failed to get place from current location! %@", error);
 
 		            return;
 				}
@@ -0,0 +1,32 @@
+//
+//  CompactObjectSerializer.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `CompactObjectSerializer` converts collections of `AWFObject` instances to and from a compact binary property list.
+ *  The names of each class's `codableProperties` are written once per class, and each object is stored as an array of
+ *  its values in that order. This avoids the class and key names that `NSKeyedArchiver` repeats for every object, so large
+ *  collections of observations and forecasts are smaller and faster to restore.
+ *
+ *  Values that can't be represented in a property list are stored using `NSKeyedArchiver`.
+ */
+@interface CompactObjectSerializer : NSObject
+
+/**
+ *  Returns the serialized data for an array of objects, or `nil` if the objects couldn't be serialized.
+ */
++ (NSData *)dataWithObjects:(NSArray *)objects;
+
+/**
+ *  Returns the array of objects restored from serialized data, or `nil` if the data isn't in the serializer's format or
+ *  any part of it can't be decoded.
+ */
++ (NSArray *)objectsWithData:(NSData *)data;
+
+@end
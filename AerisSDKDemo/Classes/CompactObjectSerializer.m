@@ -0,0 +1,229 @@
+//
+//  CompactObjectSerializer.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "CompactObjectSerializer.h"
+#import "FieldUsageProfiler.h"
+
+@interface CompactObjectSerializer ()
++ (id)encodedValue:(id)value schemas:(NSMutableDictionary *)schemas;
++ (id)encodedObject:(AWFObject *)object schemas:(NSMutableDictionary *)schemas;
++ (id)archivedValue:(id)value;
++ (id)decodedValue:(id)value schemas:(NSDictionary *)schemas;
++ (id)decodedObject:(NSArray *)encodedObject schemas:(NSDictionary *)schemas;
+@end
+
+static NSString *formatVersionKey	= @"version";
+static NSString *schemasKey			= @"schemas";
+static NSString *rootKey			= @"root";
+
+static NSInteger formatVersion = 1;
+
+// non-scalar values are wrapped in a single-key dictionary whose key identifies how the value was encoded
+static NSString *objectTag		= @"o";
+static NSString *arrayTag		= @"a";
+static NSString *dictionaryTag	= @"d";
+static NSString *archiveTag		= @"k";
+
+@implementation CompactObjectSerializer
+
++ (NSData *)dataWithObjects:(NSArray *)objects {
+	if (!objects) {
+		return nil;
+	}
+
+	// reading every property to store it isn't the app using them, so keep it out of any field usage being profiled
+	NSMutableDictionary *schemas = [[NSMutableDictionary alloc] init];
+	__block id root = nil;
+	[FieldUsageProfiler performWithoutRecording:^{
+		root = [self encodedValue:objects schemas:schemas];
+	}];
+	if (!root) {
+		return nil;
+	}
+
+	NSDictionary *plist = @{formatVersionKey: @(formatVersion), schemasKey: schemas, rootKey: root};
+	return [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+}
+
++ (NSArray *)objectsWithData:(NSData *)data {
+	if (!data) {
+		return nil;
+	}
+
+	NSDictionary *plist = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL];
+	if (![plist isKindOfClass:[NSDictionary class]] || [[plist objectForKey:formatVersionKey] integerValue] != formatVersion) {
+		return nil;
+	}
+
+	id objects = nil;
+	@try {
+		objects = [self decodedValue:[plist objectForKey:rootKey] schemas:[plist objectForKey:schemasKey]];
+	}
+	@catch (NSException *exception) {
+		// a property stored by a different version of a model class no longer exists
+		return nil;
+	}
+
+	return ([objects isKindOfClass:[NSArray class]]) ? objects : nil;
+}
+
+#pragma mark - Private
+
++ (id)encodedValue:(id)value schemas:(NSMutableDictionary *)schemas {
+	if (!value || value == [NSNull null]) {
+		return nil;
+	}
+
+	if ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSDate class]] || [value isKindOfClass:[NSData class]]) {
+		return value;
+	}
+	else if ([value isKindOfClass:[AWFObject class]]) {
+		return [self encodedObject:value schemas:schemas];
+	}
+	else if ([value isKindOfClass:[NSArray class]]) {
+		NSMutableArray *encodedArray = [NSMutableArray arrayWithCapacity:[value count]];
+		for (id item in value) {
+			id encodedItem = [self encodedValue:item schemas:schemas];
+			if (!encodedItem) {
+				return [self archivedValue:value];
+			}
+			[encodedArray addObject:encodedItem];
+		}
+		return @{arrayTag: encodedArray};
+	}
+	else if ([value isKindOfClass:[NSDictionary class]]) {
+		NSMutableDictionary *encodedDictionary = [NSMutableDictionary dictionaryWithCapacity:[value count]];
+		for (id key in value) {
+			id encodedItem = [self encodedValue:[value objectForKey:key] schemas:schemas];
+			if (![key isKindOfClass:[NSString class]] || !encodedItem) {
+				return [self archivedValue:value];
+			}
+			[encodedDictionary setObject:encodedItem forKey:key];
+		}
+		return @{dictionaryTag: encodedDictionary};
+	}
+
+	return [self archivedValue:value];
+}
+
++ (id)encodedObject:(AWFObject *)object schemas:(NSMutableDictionary *)schemas {
+	NSString *className = NSStringFromClass([object class]);
+	NSArray *propertyNames = [schemas objectForKey:className];
+	if (!propertyNames) {
+		propertyNames = [[[object codableProperties] allKeys] sortedArrayUsingSelector:@selector(compare:)];
+		[schemas setObject:propertyNames forKey:className];
+	}
+
+	// a bitmap of which properties have values comes first so nil values don't need a placeholder
+	NSMutableData *presence = [NSMutableData dataWithLength:([propertyNames count] + 7) / 8];
+	uint8_t *bits = [presence mutableBytes];
+
+	NSMutableArray *encodedObject = [NSMutableArray arrayWithCapacity:[propertyNames count] + 2];
+	[encodedObject addObject:className];
+	[encodedObject addObject:presence];
+
+	[propertyNames enumerateObjectsUsingBlock:^(NSString *name, NSUInteger idx, BOOL *stop) {
+		id encodedValue = [self encodedValue:[object valueForKey:name] schemas:schemas];
+		if (encodedValue) {
+			bits[idx / 8] |= (1 << (idx % 8));
+			[encodedObject addObject:encodedValue];
+		}
+	}];
+
+	return @{objectTag: encodedObject};
+}
+
++ (id)archivedValue:(id)value {
+	NSData *data = nil;
+	@try {
+		data = [NSKeyedArchiver archivedDataWithRootObject:value];
+	}
+	@catch (NSException *exception) {
+		return nil;
+	}
+
+	return (data) ? @{archiveTag: data} : nil;
+}
+
++ (id)decodedValue:(id)value schemas:(NSDictionary *)schemas {
+	if (![value isKindOfClass:[NSDictionary class]]) {
+		return value;
+	}
+
+	id contents = nil;
+	if ((contents = [value objectForKey:objectTag])) {
+		return [self decodedObject:contents schemas:schemas];
+	}
+	else if ((contents = [value objectForKey:arrayTag])) {
+		// an item that can't be decoded means the data is corrupt or from another version, and returning the rest would
+		// look like a valid but shorter list
+		NSMutableArray *array = [NSMutableArray arrayWithCapacity:[contents count]];
+		for (id item in contents) {
+			id decodedItem = [self decodedValue:item schemas:schemas];
+			if (!decodedItem) {
+				return nil;
+			}
+			[array addObject:decodedItem];
+		}
+		return array;
+	}
+	else if ((contents = [value objectForKey:dictionaryTag])) {
+		__block BOOL failed = NO;
+		NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:[contents count]];
+		[contents enumerateKeysAndObjectsUsingBlock:^(NSString *key, id item, BOOL *stop) {
+			id decodedItem = [self decodedValue:item schemas:schemas];
+			if (!decodedItem) {
+				failed = YES;
+				*stop = YES;
+				return;
+			}
+			[dictionary setObject:decodedItem forKey:key];
+		}];
+		return (failed) ? nil : dictionary;
+	}
+	else if ((contents = [value objectForKey:archiveTag])) {
+		return [NSKeyedUnarchiver unarchiveObjectWithData:contents];
+	}
+
+	return nil;
+}
+
++ (id)decodedObject:(NSArray *)encodedObject schemas:(NSDictionary *)schemas {
+	if ([encodedObject count] < 2) {
+		return nil;
+	}
+
+	NSString *className = [encodedObject objectAtIndex:0];
+	NSArray *propertyNames = [schemas objectForKey:className];
+	NSData *presence = [encodedObject objectAtIndex:1];
+	Class objectClass = NSClassFromString(className);
+	if (!objectClass || !propertyNames || [presence length] < ([propertyNames count] + 7) / 8) {
+		return nil;
+	}
+
+	id object = [[objectClass alloc] init];
+	const uint8_t *bits = [presence bytes];
+	NSUInteger valueIndex = 2;
+
+	for (NSUInteger idx = 0; idx < [propertyNames count]; idx++) {
+		if (!(bits[idx / 8] & (1 << (idx % 8)))) {
+			continue;
+		}
+
+		// every property marked as present must have a value that decodes
+		id value = (valueIndex < [encodedObject count]) ? [self decodedValue:[encodedObject objectAtIndex:valueIndex++] schemas:schemas] : nil;
+		if (!value) {
+			return nil;
+		}
+		[object setValue:value forKey:[propertyNames objectAtIndex:idx]];
+	}
+
+	return object;
+}
+
+@end
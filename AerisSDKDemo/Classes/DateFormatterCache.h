@@ -0,0 +1,49 @@
+//
+//  DateFormatterCache.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `DateFormatterCache` formats dates for display without creating or reconfiguring an `NSDateFormatter` each time. Each
+ *  thread keeps its own formatters, one for every combination of format, time zone and locale it has used, and the
+ *  formatted strings are remembered so that redisplaying the same dates while scrolling doesn't format them again.
+ *
+ *  The formatters and strings are discarded whenever the current locale, the system time zone or the day changes.
+ *
+ *  All methods can be called from any thread.
+ */
+@interface DateFormatterCache : NSObject
+
+/**
+ *  Returns a formatter for the current thread configured with a format, time zone and locale. The formatter must not be
+ *  modified or used from another thread.
+ *
+ *  @param format   The date format, e.g. `@"h:mm a"`.
+ *  @param timeZone The time zone, or `nil` to use the local time zone.
+ *  @param locale   The locale, or `nil` to use the current locale.
+ */
++ (NSDateFormatter *)formatterWithFormat:(NSString *)format timeZone:(NSTimeZone *)timeZone locale:(NSLocale *)locale;
+
+/**
+ *  Returns the string for a date in a format using the current locale. Unlike `awf_stringWithFormat:`, which uses the time
+ *  zone last passed to `awf_setDefaultTimezone:`, the time zone is always given here, so formatting neither depends on nor
+ *  changes that shared default.
+ *
+ *  @param date     The date to format.
+ *  @param format   The date format, e.g. `@"h:mm a"`.
+ *  @param timeZone The time zone, or `nil` to use the local time zone.
+ */
++ (NSString *)stringFromDate:(NSDate *)date format:(NSString *)format timeZone:(NSTimeZone *)timeZone;
+
+/**
+ *  Discards all formatters and formatted strings. This is called automatically when the current locale, the system time
+ *  zone or the day changes.
+ */
++ (void)invalidate;
+
+@end
@@ -0,0 +1,115 @@
+//
+//  DateFormatterCache.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "DateFormatterCache.h"
+
+@interface DateFormatterCache ()
++ (void)startObservingIfNeeded;
++ (NSUInteger)currentGeneration;
++ (NSCache *)stringCache;
+@end
+
+static NSString *threadFormattersKey = @"DateFormatterCacheFormatters";
+static NSString *threadGenerationKey = @"DateFormatterCacheGeneration";
+
+static NSUInteger generation = 0;
+
+@implementation DateFormatterCache
+
++ (NSDateFormatter *)formatterWithFormat:(NSString *)format timeZone:(NSTimeZone *)timeZone locale:(NSLocale *)locale {
+	[self startObservingIfNeeded];
+
+	timeZone = (timeZone) ? timeZone : [NSTimeZone localTimeZone];
+	locale = (locale) ? locale : [NSLocale currentLocale];
+
+	// each thread has its own formatters since NSDateFormatter isn't safe to share between threads, and they're thrown away
+	// on the next use after the cache has been invalidated
+	NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+	NSMutableDictionary *formatters = [threadDictionary objectForKey:threadFormattersKey];
+	NSUInteger currentGeneration = [self currentGeneration];
+	if (!formatters || [[threadDictionary objectForKey:threadGenerationKey] unsignedIntegerValue] != currentGeneration) {
+		formatters = [[NSMutableDictionary alloc] init];
+		[threadDictionary setObject:formatters forKey:threadFormattersKey];
+		[threadDictionary setObject:@(currentGeneration) forKey:threadGenerationKey];
+	}
+
+	NSString *key = [NSString stringWithFormat:@"%@|%@|%@", format, [timeZone name], [locale localeIdentifier]];
+	NSDateFormatter *formatter = [formatters objectForKey:key];
+	if (!formatter) {
+		formatter = [[NSDateFormatter alloc] init];
+		formatter.dateFormat = format;
+		formatter.timeZone = timeZone;
+		formatter.locale = locale;
+		[formatters setObject:formatter forKey:key];
+	}
+
+	return formatter;
+}
+
++ (NSString *)stringFromDate:(NSDate *)date format:(NSString *)format timeZone:(NSTimeZone *)timeZone {
+	if (!date || !format) {
+		return nil;
+	}
+
+	timeZone = (timeZone) ? timeZone : [NSTimeZone localTimeZone];
+	NSLocale *locale = [NSLocale currentLocale];
+
+	// none of the display formats go below seconds, so every date within the same second produces the same string
+	NSString *key = [NSString stringWithFormat:@"%@|%@|%@|%.0f", format, [timeZone name], [locale localeIdentifier], floor([date timeIntervalSinceReferenceDate])];
+	NSString *string = [[self stringCache] objectForKey:key];
+	if (!string) {
+		string = [[self formatterWithFormat:format timeZone:timeZone locale:locale] stringFromDate:date];
+		if (string) {
+			[[self stringCache] setObject:string forKey:key];
+		}
+	}
+
+	return string;
+}
+
++ (void)invalidate {
+	@synchronized(self) {
+		generation++;
+	}
+	[[self stringCache] removeAllObjects];
+}
+
+#pragma mark - Private
+
++ (void)startObservingIfNeeded {
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+		NSArray *names = @[NSCurrentLocaleDidChangeNotification, NSSystemTimeZoneDidChangeNotification, UIApplicationSignificantTimeChangeNotification];
+		for (NSString *name in names) {
+			[center addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification *notification) {
+				[NSTimeZone resetSystemTimeZone];
+				[DateFormatterCache invalidate];
+			}];
+		}
+	});
+}
+
++ (NSUInteger)currentGeneration {
+	@synchronized(self) {
+		return generation;
+	}
+}
+
++ (NSCache *)stringCache {
+	static NSCache *_stringCache = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		_stringCache = [[NSCache alloc] init];
+		_stringCache.countLimit = 1000;
+	});
+
+	return _stringCache;
+}
+
+@end
@@ -0,0 +1,55 @@
+//
+//  FieldUsageProfiler.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `FieldUsageProfiler` records which properties of `AWFObject` model classes are actually read by the app and generates
+ *  the minimal `fields` string for `AWFRequestOptions` that covers them, using each class's `propertyMappings` to
+ *  translate property names back into API field names.
+ *
+ *  Profiling replaces the getters of the profiled classes at runtime, so it is intended for debug builds only. Usage should
+ *  be recorded by exercising every screen that displays a class before relying on the generated fields, since any property
+ *  that wasn't read while profiling will be missing from requests that use them.
+ */
+@interface FieldUsageProfiler : NSObject
+
++ (FieldUsageProfiler *)sharedProfiler;
+
+/**
+ *  Performs a block without recording the property reads it makes on the current thread. This is used for code that reads
+ *  every property rather than the ones the app displays, such as serializing objects for the cache.
+ */
++ (void)performWithoutRecording:(dispatch_block_t)block;
+
+/**
+ *  Starts recording property reads for instances of the model class and any of its related model classes.
+ *
+ *  @param objectClass An `AWFObject` subclass, e.g. `[AWFObservation class]`.
+ */
+- (void)startProfilingObjectClass:(Class)objectClass;
+
+/**
+ *  Returns the names of the properties that have been read on instances of the model class.
+ */
+- (NSSet *)propertiesReadForObjectClass:(Class)objectClass;
+
+/**
+ *  Returns a comma-separated `fields` string covering every property read on the model class, or `nil` if no usage has been
+ *  recorded for it yet.
+ */
+- (NSString *)fieldsForObjectClass:(Class)objectClass;
+
+/**
+ *  Logs the generated `fields` string for every profiled class.
+ */
+- (void)logProfiledFields;
+
+- (void)reset;
+
+@end
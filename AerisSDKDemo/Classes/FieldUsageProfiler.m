@@ -0,0 +1,227 @@
+//
+//  FieldUsageProfiler.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "FieldUsageProfiler.h"
+#import <objc/runtime.h>
+
+@interface FieldUsageProfiler ()
+@property (nonatomic, strong) NSMutableDictionary *usage;
+@property (nonatomic, strong) NSMutableSet *profiledClasses;
+@property (nonatomic, strong) NSMutableSet *instrumentedGetters;
+- (void)instrumentGettersForClass:(Class)objectClass;
+- (void)recordProperty:(NSString *)property forObject:(id)object;
+- (Class)relatedClassForProperty:(NSString *)property inClass:(Class)objectClass;
+- (NSArray *)fieldsForObjectClass:(Class)objectClass prefix:(NSString *)prefix depth:(NSUInteger)depth;
+@end
+
+static NSUInteger maximumRelationshipDepth = 2;
+
+static NSString *suspendedRecordingCountKey = @"FieldUsageProfilerSuspendedRecordingCount";
+
+@implementation FieldUsageProfiler
+
++ (FieldUsageProfiler *)sharedProfiler {
+	static FieldUsageProfiler *_sharedProfiler = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		_sharedProfiler = [[FieldUsageProfiler alloc] init];
+	});
+
+	return _sharedProfiler;
+}
+
++ (void)performWithoutRecording:(dispatch_block_t)block {
+	// keep a count rather than a flag so nested calls don't resume recording early
+	NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+	NSInteger count = [[threadDictionary objectForKey:suspendedRecordingCountKey] integerValue];
+	[threadDictionary setObject:@(count + 1) forKey:suspendedRecordingCountKey];
+
+	@try {
+		block();
+	}
+	@finally {
+		[threadDictionary setObject:@(count) forKey:suspendedRecordingCountKey];
+	}
+}
+
+#pragma mark - Instance Methods
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_usage = [[NSMutableDictionary alloc] init];
+		_profiledClasses = [[NSMutableSet alloc] init];
+		_instrumentedGetters = [[NSMutableSet alloc] init];
+	}
+	return self;
+}
+
+- (void)startProfilingObjectClass:(Class)objectClass {
+	if (![objectClass isSubclassOfClass:[AWFObject class]]) {
+		return;
+	}
+
+	@synchronized(self) {
+		NSString *className = NSStringFromClass(objectClass);
+		if ([self.profiledClasses containsObject:className]) {
+			return;
+		}
+		[self.profiledClasses addObject:className];
+
+		// walk up to AWFObject so inherited properties (e.g. AWFGeographicObject's) are recorded too
+		Class cls = objectClass;
+		while (cls && cls != [AWFObject class]) {
+			[self instrumentGettersForClass:cls];
+			cls = class_getSuperclass(cls);
+		}
+	}
+
+	// profile related model classes as well so nested fields such as forecast periods can be projected
+	[[[objectClass propertyRelationships] allKeys] enumerateObjectsUsingBlock:^(NSString *property, NSUInteger idx, BOOL *stop) {
+		Class relatedClass = [self relatedClassForProperty:property inClass:objectClass];
+		if (relatedClass) {
+			[self startProfilingObjectClass:relatedClass];
+		}
+	}];
+}
+
+- (NSSet *)propertiesReadForObjectClass:(Class)objectClass {
+	@synchronized(self) {
+		return [[self.usage objectForKey:NSStringFromClass(objectClass)] copy];
+	}
+}
+
+- (NSString *)fieldsForObjectClass:(Class)objectClass {
+	NSArray *fields = [self fieldsForObjectClass:objectClass prefix:nil depth:0];
+	if ([fields count] == 0) {
+		return nil;
+	}
+
+	NSArray *sortedFields = [[[NSSet setWithArray:fields] allObjects] sortedArrayUsingSelector:@selector(compare:)];
+	return [sortedFields componentsJoinedByString:@","];
+}
+
+- (void)logProfiledFields {
+	NSArray *classNames = nil;
+	@synchronized(self) {
+		classNames = [[self.profiledClasses allObjects] sortedArrayUsingSelector:@selector(compare:)];
+	}
+
+	[classNames enumerateObjectsUsingBlock:^(NSString *className, NSUInteger idx, BOOL *stop) {
+		NSString *fields = [self fieldsForObjectClass:NSClassFromString(className)];
+		if (fields) {
+			AppLogInfo(@"%@ fields: %@", className, fields);
+		}
+	}];
+}
+
+- (void)reset {
+	@synchronized(self) {
+		[self.usage removeAllObjects];
+	}
+}
+
+#pragma mark - Private
+
+- (void)instrumentGettersForClass:(Class)objectClass {
+	unsigned int count = 0;
+	objc_property_t *properties = class_copyPropertyList(objectClass, &count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		NSString *name = [NSString stringWithUTF8String:property_getName(properties[i])];
+
+		// only object properties are instrumented, which covers every mapped value since they are boxed
+		char *type = property_copyAttributeValue(properties[i], "T");
+		BOOL isObject = (type && type[0] == '@');
+		free(type);
+		if (!isObject) {
+			continue;
+		}
+
+		char *getterName = property_copyAttributeValue(properties[i], "G");
+		SEL getter = (getterName) ? sel_registerName(getterName) : NSSelectorFromString(name);
+		free(getterName);
+
+		NSString *identifier = [NSString stringWithFormat:@"%@.%@", NSStringFromClass(objectClass), NSStringFromSelector(getter)];
+		Method method = class_getInstanceMethod(objectClass, getter);
+		if (!method || [self.instrumentedGetters containsObject:identifier]) {
+			continue;
+		}
+		[self.instrumentedGetters addObject:identifier];
+
+		IMP originalIMP = method_getImplementation(method);
+		IMP profilingIMP = imp_implementationWithBlock(^id(id object) {
+			[self recordProperty:name forObject:object];
+			return ((id (*)(id, SEL))originalIMP)(object, getter);
+		});
+
+		// add the method to this class if it's inherited so the superclass implementation is left untouched
+		if (!class_addMethod(objectClass, getter, profilingIMP, method_getTypeEncoding(method))) {
+			method_setImplementation(method, profilingIMP);
+		}
+	}
+
+	free(properties);
+}
+
+- (void)recordProperty:(NSString *)property forObject:(id)object {
+	if ([[[[NSThread currentThread] threadDictionary] objectForKey:suspendedRecordingCountKey] integerValue] > 0) {
+		return;
+	}
+
+	@synchronized(self) {
+		NSString *className = NSStringFromClass([object class]);
+		NSMutableSet *properties = [self.usage objectForKey:className];
+		if (!properties) {
+			properties = [[NSMutableSet alloc] init];
+			[self.usage setObject:properties forKey:className];
+		}
+		[properties addObject:property];
+	}
+}
+
+- (Class)relatedClassForProperty:(NSString *)property inClass:(Class)objectClass {
+	id relationship = [[objectClass propertyRelationships] objectForKey:property];
+	if ([relationship isKindOfClass:[NSString class]]) {
+		return NSClassFromString(relationship);
+	}
+	else if (class_isMetaClass(object_getClass(relationship))) {
+		return relationship;
+	}
+	return nil;
+}
+
+- (NSArray *)fieldsForObjectClass:(Class)objectClass prefix:(NSString *)prefix depth:(NSUInteger)depth {
+	NSSet *propertiesRead = [self propertiesReadForObjectClass:objectClass];
+	if ([propertiesRead count] == 0) {
+		return nil;
+	}
+
+	NSMutableArray *fields = [[NSMutableArray alloc] init];
+	[[objectClass propertyMappings] enumerateKeysAndObjectsUsingBlock:^(NSString *field, id property, BOOL *stop) {
+		if (![property isKindOfClass:[NSString class]] || ![propertiesRead containsObject:property]) {
+			return;
+		}
+
+		NSString *path = (prefix) ? [NSString stringWithFormat:@"%@.%@", prefix, field] : field;
+
+		// narrow related objects down to the fields read on them, otherwise request the whole object
+		Class relatedClass = [self relatedClassForProperty:property inClass:objectClass];
+		NSArray *relatedFields = (relatedClass && depth < maximumRelationshipDepth) ? [self fieldsForObjectClass:relatedClass prefix:path depth:depth + 1] : nil;
+		if ([relatedFields count] > 0) {
+			[fields addObjectsFromArray:relatedFields];
+		}
+		else {
+			[fields addObject:path];
+		}
+	}];
+
+	return fields;
+}
+
+@end
@@ -7,3 +7,8 @@
 //
 
 extern NSString *kAWFDemoDefaultStyleChanged;
+
+/**
+ *  Returns the SHA-1 digest of the data as a lowercase hexadecimal string.
+ */
+extern NSString *AWFDemoSHA1String(NSData *data);
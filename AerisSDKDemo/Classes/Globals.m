@@ -7,5 +7,18 @@
 //
 
 #import "Globals.h"
+#import <CommonCrypto/CommonDigest.h>
 
 NSString *kAWFDemoDefaultStyleChanged      = @"StyleChanged";
+
+NSString *AWFDemoSHA1String(NSData *data) {
+	unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+	CC_SHA1([data bytes], (CC_LONG)[data length], digest);
+
+	NSMutableString *string = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+	for (NSInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++) {
+		[string appendFormat:@"%02x", digest[i]];
+	}
+
+	return string;
+}
@@ -95,8 +95,7 @@
 #pragma mark - AWFGraphViewDelegate
 
 - (void)graphView:(AWFGraphView *)graphView didSelectItemForSeries:(AWFSeriesItem *)seriesItem atIndex:(NSInteger)index {
-	AWFSeriesPoint *point = seriesItem.points[index];
-	NSLog(@"selected point at %lu: value=%.2f", index, point.y);
+	AppLogDebug(@"selected point at %lu: value=%.2f", index, ((AWFSeriesPoint *)seriesItem.points[index]).y);
 }
 
 #pragma mark - GraphViewControllerDelegate
@@ -46,7 +46,7 @@ static NSString *cellIdentifier = @"GroupedListingCellIdentifier";
 		__weak typeof(self) weakSelf = self;
 		[self.loader getForPlace:place options:options completion:^(NSArray *objects, NSError *error) {
 			if (error) {
-				NSLog(@"Listing data failed to load! %@", error);
+				AppLogError(@"Listing data failed to load! %@", error);
 				[weakSelf.eventView showMessage:NSLocalizedString(@"An error occurred during the request.", nil)];
 				return;
 			}
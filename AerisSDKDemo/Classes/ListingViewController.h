@@ -19,6 +19,12 @@
 
 - (void)loadDataClosestToPlace:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options;
 
+/**
+ *  Loads the results one page of `options.limit` objects at a time, appending the next page as the table is scrolled to the
+ *  bottom. The following page is prefetched while the current one is displayed.
+ */
+- (void)loadPagedDataClosestToPlace:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options;
+
 - (void)handleConfigurationOfCell:(UITableViewCell *)cell forIndexPath:(NSIndexPath *)indexPath;
 - (void)handleCellSelectionForIndexPath:(NSIndexPath *)indexPath;
 
@@ -9,9 +9,12 @@
 #import "ListingViewController.h"
 #import "ListingEventView.h"
 #import "ListingTableViewCell.h"
+#import "LoaderPager.h"
 
 @interface ListingViewController ()
-
+@property (nonatomic, strong) LoaderPager *pager;
+@property (nonatomic, assign) BOOL waitingForPage;
+- (void)loadNextPage;
 @end
 
 static NSString *cellIdentifier = @"ListingCellIdentifier";
@@ -56,13 +59,17 @@ static NSString *cellIdentifier = @"ListingCellIdentifier";
 #pragma mark - Public
 
 - (void)loadDataClosestToPlace:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options {
+	[self.pager cancel];
+	self.pager = nil;
+	self.waitingForPage = NO;
+	
 	if (self.loader) {
 		[self.eventView showLoading];
 		
 		__weak typeof(self) weakSelf = self;
 		[self.loader getClosestToPlace:place radius:radius options:options completion:^(NSArray *objects, NSError *error) {
 			if (error) {
-				NSLog(@"Listing data failed to load! %@", error);
+				AppLogError(@"Listing data failed to load! %@", error);
 				[weakSelf.eventView showMessage:NSLocalizedString(@"An error occurred during the request.", nil)];
 				return;
 			}
@@ -80,6 +87,24 @@ static NSString *cellIdentifier = @"ListingCellIdentifier";
 	}
 }
 
+- (void)loadPagedDataClosestToPlace:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options {
+	[self.pager cancel];
+	self.pager = nil;
+	self.waitingForPage = NO;
+	
+	if (self.loader) {
+		[self.eventView showLoading];
+		
+		self.results = @[];
+		[self.tableView reloadData];
+		
+		self.pager = [[LoaderPager alloc] initWithLoader:self.loader options:options requestBlock:^(AWFObjectLoader *loader, AWFRequestOptions *pageOptions, AWFObjectLoaderCompletionBlock completionBlock) {
+			[(AWFGeographicObjectLoader *)loader getClosestToPlace:place radius:radius options:pageOptions completion:completionBlock];
+		}];
+		[self loadNextPage];
+	}
+}
+
 - (void)handleConfigurationOfCell:(UITableViewCell *)cell forIndexPath:(NSIndexPath *)indexPath {
 	// subclassing controllers should override to provide necessary functionality
 }
@@ -88,6 +113,43 @@ static NSString *cellIdentifier = @"ListingCellIdentifier";
 	// subclassing controllers should override to provide necessary functionality
 }
 
+#pragma mark - Private
+
+- (void)loadNextPage {
+	if (!self.pager.hasMorePages || self.waitingForPage) {
+		return;
+	}
+	
+	LoaderPager *pager = self.pager;
+	self.waitingForPage = YES;
+	
+	__weak typeof(self) weakSelf = self;
+	[pager nextPageWithCompletion:^(NSArray *objects, NSUInteger page, BOOL isLastPage, NSError *error) {
+		// ignore pages from a pager that has since been replaced
+		if (weakSelf.pager != pager) {
+			return;
+		}
+		weakSelf.waitingForPage = NO;
+		
+		if (error) {
+			AppLogError(@"Listing data failed to load! %@", error);
+			if ([weakSelf.results count] == 0) {
+				[weakSelf.eventView showMessage:NSLocalizedString(@"An error occurred during the request.", nil)];
+			}
+			return;
+		}
+		
+		if ([objects count] > 0) {
+			weakSelf.results = [weakSelf.results arrayByAddingObjectsFromArray:objects];
+			[weakSelf.tableView reloadData];
+			[weakSelf.eventView hide];
+		}
+		else if ([weakSelf.results count] == 0) {
+			[weakSelf.eventView showNoResultsMessage];
+		}
+	}];
+}
+
 #pragma mark - UITableViewDataSource
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
@@ -107,6 +169,13 @@ static NSString *cellIdentifier = @"ListingCellIdentifier";
 
 #pragma mark - UITableViewDelegate
 
+- (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath {
+	// request the next page once the last row comes into view
+	if (self.pager && indexPath.row == (NSInteger)[self.results count] - 1) {
+		[self loadNextPage];
+	}
+}
+
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
 	[self handleCellSelectionForIndexPath:indexPath];
 	[tableView deselectRowAtIndexPath:indexPath animated:YES];
@@ -0,0 +1,85 @@
+//
+//  LoaderPager.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The block used to request a single page. The block should start a request with the provided loader and options, which
+ *  already have their `limit` and `skip` values set for the page, and call the completion block when it finishes.
+ */
+typedef void (^LoaderPagerRequestBlock)(AWFObjectLoader *loader, AWFRequestOptions *options, AWFObjectLoaderCompletionBlock completionBlock);
+
+/**
+ *  The block called with each page of objects. `isLastPage` is `YES` once the API returns fewer objects than the page size.
+ */
+typedef void (^LoaderPagerPageBlock)(NSArray *objects, NSUInteger page, BOOL isLastPage, NSError *error);
+
+/**
+ *  `LoaderPager` walks a large result set one page at a time using the `limit` and `skip` request options. While the
+ *  caller handles one page, the pager loads the following pages in the background so they are ready when requested,
+ *  holding no more than `maximumBufferedPages` loaded pages at once.
+ *
+ *  All methods must be called from the main thread.
+ */
+@interface LoaderPager : NSObject
+
+/**
+ *  The number of objects to request for each page. Defaults to the `limit` of the options provided at initialization, or
+ *  `25` if no limit was set.
+ */
+@property (nonatomic, assign) NSUInteger pageSize;
+
+/**
+ *  The maximum number of loaded pages to hold that haven't been requested yet. Prefetching pauses when the limit is
+ *  reached and resumes as pages are handed out. Defaults to `1`.
+ */
+@property (nonatomic, assign) NSUInteger maximumBufferedPages;
+
+/**
+ *  Whether or not there are more pages to request.
+ */
+@property (readonly, nonatomic) BOOL hasMorePages;
+
+/**
+ *  Whether or not a page is currently being loaded.
+ */
+@property (readonly, nonatomic) BOOL isLoading;
+
+/**
+ *  Initializes and returns a pager that requests each page using the loader's `getWithOptions:completion:` method.
+ *
+ *  @param loader  The object loader to request pages with. The pager uses its own copy of the loader.
+ *  @param options The request options to use for each page, or `nil` to use the loader's defaults.
+ */
+- (instancetype)initWithLoader:(AWFObjectLoader *)loader options:(AWFRequestOptions *)options;
+
+/**
+ *  Initializes and returns a pager that requests each page using a custom request block, such as one calling
+ *  `getClosestToPlace:radius:options:completion:` for a geographic loader.
+ *
+ *  @param loader       The object loader to request pages with. The pager uses its own copy of the loader.
+ *  @param options      The request options to use for each page, or `nil` to use the loader's defaults.
+ *  @param requestBlock The block used to request each page.
+ */
+- (instancetype)initWithLoader:(AWFObjectLoader *)loader options:(AWFRequestOptions *)options requestBlock:(LoaderPagerRequestBlock)requestBlock;
+
+/**
+ *  Returns the next page of objects, either from the pages already prefetched or by waiting for it to load. Only one
+ *  page can be requested at a time, so the completion block is called with `nil` objects and no error if a previous request
+ *  for the next page is still waiting.
+ *
+ *  @param completionBlock The block to call with the next page.
+ */
+- (void)nextPageWithCompletion:(LoaderPagerPageBlock)completionBlock;
+
+/**
+ *  Cancels any page being loaded and discards the prefetched pages. The pager can't be used after being cancelled.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,171 @@
+//
+//  LoaderPager.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "LoaderPager.h"
+
+@interface LoaderPagerPage : NSObject
+@property (nonatomic, strong) NSArray *objects;
+@property (nonatomic, assign) NSUInteger index;
+@property (nonatomic, assign) BOOL isLastPage;
+@end
+
+@implementation LoaderPagerPage
+@end
+
+
+@interface LoaderPager ()
+@property (nonatomic, strong) AWFObjectLoader *loader;
+@property (nonatomic, strong) AWFRequestOptions *options;
+@property (nonatomic, copy) LoaderPagerRequestBlock requestBlock;
+@property (nonatomic, strong) NSMutableArray *bufferedPages;
+@property (nonatomic, copy) LoaderPagerPageBlock pendingCompletionBlock;
+@property (nonatomic, assign) NSUInteger nextPageIndex;
+@property (nonatomic, assign) BOOL loading;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL cancelled;
+- (void)prefetchIfNeeded;
+- (void)loadPageAtIndex:(NSUInteger)index;
+- (void)finishLoadingPageAtIndex:(NSUInteger)index objects:(NSArray *)objects error:(NSError *)error;
+@end
+
+static NSUInteger defaultPageSize = 25;
+
+@implementation LoaderPager
+
+- (instancetype)initWithLoader:(AWFObjectLoader *)loader options:(AWFRequestOptions *)options {
+	return [self initWithLoader:loader options:options requestBlock:^(AWFObjectLoader *pageLoader, AWFRequestOptions *pageOptions, AWFObjectLoaderCompletionBlock completionBlock) {
+		[pageLoader getWithOptions:pageOptions completion:completionBlock];
+	}];
+}
+
+- (instancetype)initWithLoader:(AWFObjectLoader *)loader options:(AWFRequestOptions *)options requestBlock:(LoaderPagerRequestBlock)requestBlock {
+	self = [super init];
+	if (self) {
+		// each page is configured through the options, so work from copies of both the loader and options
+		_loader = [loader copy];
+		_options = (options) ? [AWFRequestOptions requestOptionsFromDictionary:[options optionsAsDictionary]] : [AWFRequestOptions options];
+		_requestBlock = [requestBlock copy];
+		_pageSize = (options.limit > 0) ? options.limit : defaultPageSize;
+		_maximumBufferedPages = 1;
+		_bufferedPages = [[NSMutableArray alloc] init];
+	}
+	return self;
+}
+
+- (BOOL)hasMorePages {
+	return (!self.cancelled && ([self.bufferedPages count] > 0 || !self.finished));
+}
+
+- (BOOL)isLoading {
+	return self.loading;
+}
+
+- (void)nextPageWithCompletion:(LoaderPagerPageBlock)completionBlock {
+	if (!completionBlock) {
+		return;
+	}
+
+	if (self.cancelled || self.pendingCompletionBlock) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(nil, self.nextPageIndex, !self.hasMorePages, nil);
+		});
+		return;
+	}
+
+	// hand out the oldest prefetched page and let prefetching continue now that there's room in the buffer
+	if ([self.bufferedPages count] > 0) {
+		LoaderPagerPage *page = [self.bufferedPages firstObject];
+		[self.bufferedPages removeObjectAtIndex:0];
+
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(page.objects, page.index, page.isLastPage, nil);
+		});
+		[self prefetchIfNeeded];
+		return;
+	}
+
+	if (self.finished) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(@[], self.nextPageIndex, YES, nil);
+		});
+		return;
+	}
+
+	self.pendingCompletionBlock = completionBlock;
+	[self prefetchIfNeeded];
+}
+
+- (void)cancel {
+	self.cancelled = YES;
+	self.pendingCompletionBlock = nil;
+	[self.bufferedPages removeAllObjects];
+	[self.loader cancel];
+}
+
+#pragma mark - Private
+
+- (void)prefetchIfNeeded {
+	if (self.loading || self.finished || self.cancelled) {
+		return;
+	}
+
+	// a waiting caller always gets a request, otherwise stop once the buffer is full
+	if (!self.pendingCompletionBlock && [self.bufferedPages count] >= self.maximumBufferedPages) {
+		return;
+	}
+
+	[self loadPageAtIndex:self.nextPageIndex];
+}
+
+- (void)loadPageAtIndex:(NSUInteger)index {
+	AWFRequestOptions *pageOptions = [AWFRequestOptions requestOptionsFromDictionary:[self.options optionsAsDictionary]];
+	pageOptions.limit = self.pageSize;
+	pageOptions.skip = self.options.skip + index * self.pageSize;
+
+	self.loading = YES;
+
+	__weak typeof(self) weakSelf = self;
+	self.requestBlock(self.loader, pageOptions, ^(NSArray *objects, NSError *error) {
+		[weakSelf finishLoadingPageAtIndex:index objects:objects error:error];
+	});
+}
+
+- (void)finishLoadingPageAtIndex:(NSUInteger)index objects:(NSArray *)objects error:(NSError *)error {
+	if (self.cancelled) {
+		return;
+	}
+
+	self.loading = NO;
+
+	// a short page means the end of the result set has been reached
+	if (!error) {
+		self.nextPageIndex = index + 1;
+		self.finished = ([objects count] < self.pageSize);
+	}
+
+	LoaderPagerPageBlock completionBlock = self.pendingCompletionBlock;
+	self.pendingCompletionBlock = nil;
+
+	if (completionBlock) {
+		completionBlock(objects, index, (!error && self.finished), error);
+	}
+	else if (!error) {
+		LoaderPagerPage *page = [[LoaderPagerPage alloc] init];
+		page.objects = objects;
+		page.index = index;
+		page.isLastPage = self.finished;
+		[self.bufferedPages addObject:page];
+	}
+
+	// a failed page is requested again the next time a page is needed rather than retried here
+	if (!error) {
+		[self prefetchIfNeeded];
+	}
+}
+
+@end
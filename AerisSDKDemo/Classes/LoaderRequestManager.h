@@ -0,0 +1,275 @@
+//
+//  LoaderRequestManager.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ResponseCache;
+@class RequestMetrics;
+
+extern NSString * const LoaderRequestManagerErrorDomain;
+
+/**
+ *  The error code returned when a request is not sent because its endpoint's circuit breaker is open and no cached objects
+ *  are available.
+ */
+extern NSInteger const LoaderRequestManagerErrorCodeEndpointUnavailable;
+
+/**
+ *  The block called for stale-while-revalidate requests. `isStale` is `YES` when the objects came from an expired cache
+ *  entry and fresh objects are being requested, or when those fresh objects couldn't be loaded, in which case `objects`
+ *  is `nil` and `error` is set.
+ */
+typedef void (^LoaderRequestStaleCompletionBlock)(NSArray *objects, BOOL isStale, NSError *error);
+
+/**
+ *  The priority classes for loader requests.
+ */
+typedef NS_ENUM (NSInteger, LoaderRequestPriority) {
+	/**
+	 *  Requests that refresh data in the background. These are held until no visible requests are in progress.
+	 */
+	LoaderRequestPriorityBackground = 0,
+	/**
+	 *  Requests for data that is currently on screen. This is the default.
+	 */
+	LoaderRequestPriorityVisible
+};
+
+/**
+ *  `LoaderRequestManager` routes object loader requests from the demo's view controllers through a single registry so
+ *  that identical requests made at the same time share one API request. Each caller still receives the mapped objects
+ *  through its own completion block.
+ *
+ *  Requests are loaded with a copy of the caller's loader, and callers' loaders are only referenced weakly, so a caller
+ *  can release its loader at any time. A request is cancelled once the loaders of all callers waiting on it are gone.
+ *
+ *  All methods must be called from the main thread, which is also where the object loaders deliver their results.
+ */
+@interface LoaderRequestManager : NSObject
+
+/**
+ *  The cache used for requests made with an expiration interval. Defaults to the shared `ResponseCache`.
+ */
+@property (nonatomic, strong) ResponseCache *cache;
+
+/**
+ *  The metrics that the timing of each request sent and each cache hit are recorded to, or `nil` to disable recording,
+ *  which is the default.
+ */
+@property (nonatomic, strong) RequestMetrics *metrics;
+
+/**
+ *  The duration, in seconds, to hold new requests before sending them so that any other requests made within that window
+ *  can be combined into a single `AWFBatchLoader` request. The results are routed back to each request's completion
+ *  block. A value of `0` disables batching, which is the default.
+ */
+@property (nonatomic, assign) NSTimeInterval batchInterval;
+
+/**
+ *  The maximum number of requests combined into a single batch request. Any more requests made within the same batch window
+ *  are split across additional batch requests. Defaults to `10`.
+ *
+ *  The batch loader only returns the objects for each request, so a request in a successful batch that returned no objects
+ *  is sent again on its own to find out whether it failed, and its completion blocks receive that request's result.
+ */
+@property (nonatomic, assign) NSUInteger maximumBatchSize;
+
+/**
+ *  Whether or not requests made without a `fields` option are limited to the fields recorded for the loader's object class
+ *  by the shared `FieldUsageProfiler`. Requests for classes without any recorded usage are left unchanged. Defaults to `NO`.
+ */
+@property (nonatomic, assign) BOOL appliesProfiledFields;
+
+/**
+ *  The maximum age, in seconds, of an expired cache entry that is still shown by stale-while-revalidate requests while
+ *  fresh objects are loaded, or by any request while its endpoint's circuit breaker is open. A value of `0` removes the
+ *  limit. Defaults to 24 hours.
+ */
+@property (nonatomic, assign) NSTimeInterval maximumStaleAge;
+
+/**
+ *  The number of times a request that failed due to a transient error is retried before its completion blocks are called
+ *  with the error. Transient errors are network failures such as timeouts and lost connections, server errors with a `5xx`
+ *  status and rate limiting with a `429` status. Defaults to `2`.
+ */
+@property (nonatomic, assign) NSUInteger maximumRetryCount;
+
+/**
+ *  The base delay, in seconds, before retrying a failed request. The delay doubles with each retry and is randomized by up
+ *  to half its value so that requests that failed together don't retry together. A longer delay requested by the server with
+ *  a `Retry-After` header is used instead, up to 10 seconds; a request asked to wait longer than that fails without being
+ *  retried and opens its endpoint's circuit breaker for that long. Defaults to `1`.
+ */
+@property (nonatomic, assign) NSTimeInterval retryInterval;
+
+/**
+ *  The number of consecutive transient failures for an endpoint after which its circuit breaker opens. While open, new
+ *  requests for the endpoint are not sent and instead complete immediately with any cached objects, including expired ones
+ *  within `maximumStaleAge`, or a `LoaderRequestManagerErrorCodeEndpointUnavailable` error. Stale-while-revalidate
+ *  requests complete with that error, leaving any expired objects they already delivered marked as stale. A value of `0` disables the circuit breaker. Defaults
+ *  to `5`.
+ */
+@property (nonatomic, assign) NSUInteger circuitBreakerThreshold;
+
+/**
+ *  The duration, in seconds, that an endpoint's circuit breaker stays open, or longer if the server asked with a
+ *  `Retry-After` header. The circuit is then half open: a single request is sent without retries to test whether the
+ *  endpoint has recovered, while all other new requests are still turned away until it completes. The circuit closes if
+ *  the test request gets any response other than a transient error, and otherwise opens again. Defaults to `30`.
+ */
+@property (nonatomic, assign) NSTimeInterval circuitBreakerInterval;
+
+/**
+ *  The size, in degrees, of the grid cells that coordinate-based places are snapped to before being requested and cached.
+ *  Coordinates within the same cell then share requests and cache entries, so small changes in the device's location don't
+ *  cause new requests. The snapped coordinate is the center of its cell, which is never more than half a cell's diagonal
+ *  from the original one, so the size should be small compared to the search radius. Places identified by name or zipcode
+ *  are unaffected. A value of `0` disables snapping, which is the default.
+ */
+@property (nonatomic, assign) CLLocationDegrees coordinateGridSize;
+
++ (LoaderRequestManager *)sharedManager;
+
+/**
+ *  Requests data for a place using the loader's `getForPlace:options:completion:` method. If an identical request is
+ *  already in progress, the completion block is attached to that request instead of starting a new one.
+ *
+ *  @param loader          The object loader to use if a new request needs to be started.
+ *  @param place           The place to request data for.
+ *  @param options         The request options, or `nil` to use the loader's defaults.
+ *  @param completionBlock The block to call when the request completes.
+ */
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader
+				place:(AWFPlace *)place
+			  options:(AWFRequestOptions *)options
+		   completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+
+/**
+ *  Requests data for a place, returning the objects from the cache if they were stored within the expiration interval.
+ *  Newly loaded objects are stored in the cache for future requests.
+ *
+ *  @param loader             The object loader to use if a new request needs to be started.
+ *  @param place              The place to request data for.
+ *  @param options            The request options, or `nil` to use the loader's defaults.
+ *  @param expirationInterval The duration, in seconds, that loaded objects remain valid in the cache.
+ *  @param completionBlock    The block to call when the request completes.
+ */
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader
+				place:(AWFPlace *)place
+			  options:(AWFRequestOptions *)options
+   expirationInterval:(NSTimeInterval)expirationInterval
+		   completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+
+/**
+ *  Requests data for a place with a priority class. Background requests are deferred while any visible requests are in
+ *  progress and are sent immediately if a visible request for the same data is made in the meantime.
+ *
+ *  @param loader             The object loader to use if a new request needs to be started.
+ *  @param place              The place to request data for.
+ *  @param options            The request options, or `nil` to use the loader's defaults.
+ *  @param expirationInterval The duration, in seconds, that loaded objects remain valid in the cache.
+ *  @param priority           The priority class of the request.
+ *  @param completionBlock    The block to call when the request completes.
+ */
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader
+				place:(AWFPlace *)place
+			  options:(AWFRequestOptions *)options
+   expirationInterval:(NSTimeInterval)expirationInterval
+			 priority:(LoaderRequestPriority)priority
+		   completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+
+/**
+ *  Requests data for a place using stale-while-revalidate delivery. Unexpired cached objects are returned as with
+ *  `getWithLoader:place:options:expirationInterval:completion:`. If the cached objects have expired, the completion block
+ *  is called immediately with them flagged as stale and then called a second time with the fresh objects only if they
+ *  differ from the stale ones. If the refresh fails, the second call has no objects, is flagged as stale and includes the
+ *  error, so the caller can mark the stale objects as outdated. Entries stored longer ago than `maximumStaleAge` are
+ *  treated as if nothing was cached.
+ *
+ *  @param loader             The object loader to use if a new request needs to be started.
+ *  @param place              The place to request data for.
+ *  @param options            The request options, or `nil` to use the loader's defaults.
+ *  @param expirationInterval The duration, in seconds, that loaded objects remain valid in the cache.
+ *  @param completionBlock    The block to call with the stale and/or fresh objects.
+ */
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader
+				place:(AWFPlace *)place
+			  options:(AWFRequestOptions *)options
+   expirationInterval:(NSTimeInterval)expirationInterval
+	  staleCompletion:(LoaderRequestStaleCompletionBlock)completionBlock;
+
+/**
+ *  Requests data closest to a place using the loader's `getClosestToPlace:radius:options:completion:` method, sharing
+ *  any identical request already in progress.
+ *
+ *  @param loader          The object loader to use if a new request needs to be started.
+ *  @param place           The place to request data around.
+ *  @param radius          The search radius, e.g. `@"50mi"`.
+ *  @param options         The request options, or `nil` to use the loader's defaults.
+ *  @param completionBlock The block to call when the request completes.
+ */
+- (void)getClosestWithLoader:(AWFGeographicObjectLoader *)loader
+					   place:(AWFPlace *)place
+					  radius:(NSString *)radius
+					 options:(AWFRequestOptions *)options
+				  completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+
+/**
+ *  Requests data closest to a place, returning the objects from the cache if they were stored within the expiration
+ *  interval. Newly loaded objects are stored in the cache for future requests.
+ *
+ *  @param loader             The object loader to use if a new request needs to be started.
+ *  @param place              The place to request data around.
+ *  @param radius             The search radius, e.g. `@"50mi"`.
+ *  @param options            The request options, or `nil` to use the loader's defaults.
+ *  @param expirationInterval The duration, in seconds, that loaded objects remain valid in the cache.
+ *  @param completionBlock    The block to call when the request completes.
+ */
+- (void)getClosestWithLoader:(AWFGeographicObjectLoader *)loader
+					   place:(AWFPlace *)place
+					  radius:(NSString *)radius
+					 options:(AWFRequestOptions *)options
+		  expirationInterval:(NSTimeInterval)expirationInterval
+				  completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+
+/**
+ *  Drops the completion blocks of all requests made with the loader, which are then never called. Requests that no other
+ *  caller is waiting on are cancelled. This also happens automatically when a loader is deallocated, so calling this is only
+ *  needed while the loader is still in use.
+ *
+ *  @param loader The loader passed when the requests were made, typically owned by a view controller that is going off
+ *                screen.
+ */
+- (void)cancelRequestsForLoader:(AWFObjectLoader *)loader;
+
+/**
+ *  Returns the place that requests for a place are made and cached with, which is a place at the center of its grid cell
+ *  for coordinate-based places when `coordinateGridSize` is set, or the place itself otherwise.
+ */
+- (AWFPlace *)placeSnappedToGrid:(AWFPlace *)place;
+
+/**
+ *  Returns the key that a `getWithLoader:place:options:` request, or any of its variants, is shared and cached under. The
+ *  key is made the same way as the requests, from the place snapped to the grid, the options with any profiled fields
+ *  applied and the loader's default options, so it can be used to look up their entries in the cache.
+ */
+- (NSString *)keyForRequestWithLoader:(AWFObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options;
+
+/**
+ *  Returns the canonical key used to identify a request. Query parameters are sorted so that two sets of request options
+ *  that only differ in the order their values were assigned produce the same key.
+ */
++ (NSString *)keyForEndpoint:(NSString *)endpoint action:(NSString *)action place:(AWFPlace *)place options:(AWFRequestOptions *)options;
+
+/**
+ *  Returns the key used to identify a request made with a loader, which also includes the loader's default options so that
+ *  loaders with different defaults never share a request or cache entry.
+ */
++ (NSString *)keyForLoader:(AWFObjectLoader *)loader action:(NSString *)action place:(AWFPlace *)place options:(AWFRequestOptions *)options;
+
+@end
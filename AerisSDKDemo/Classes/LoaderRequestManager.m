@@ -0,0 +1,857 @@
+//
+//  LoaderRequestManager.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "LoaderRequestManager.h"
+#import "ResponseCache.h"
+#import "FieldUsageProfiler.h"
+#import "RequestMetrics.h"
+#import "DateFormatterCache.h"
+#import <objc/runtime.h>
+
+NSString * const LoaderRequestManagerErrorDomain = @"LoaderRequestManagerErrorDomain";
+NSInteger const LoaderRequestManagerErrorCodeEndpointUnavailable = 1;
+
+typedef void (^LoaderRequestStartBlock)(AWFObjectLoader *loader, AWFObjectLoaderCompletionBlock completionBlock);
+
+@interface LoaderRequestWaiter : NSObject
+@property (nonatomic, weak) AWFObjectLoader *owner;
+@property (nonatomic, copy) AWFObjectLoaderCompletionBlock completionBlock;
+@end
+
+@implementation LoaderRequestWaiter
+@end
+
+
+@interface LoaderRequestOwnerObserver : NSObject
+@property (nonatomic, copy) dispatch_block_t deallocBlock;
+@end
+
+@implementation LoaderRequestOwnerObserver
+
+- (void)dealloc {
+	if (_deallocBlock) {
+		_deallocBlock();
+	}
+}
+
+@end
+
+
+@interface LoaderRequest : NSObject
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, copy) NSString *endpoint;
+@property (nonatomic, assign) NSTimeInterval expirationInterval;
+@property (nonatomic, strong) AWFObjectLoader *loader;
+@property (nonatomic, copy) LoaderRequestStartBlock startBlock;
+@property (nonatomic, strong) AWFObjectLoader *batchLoader;
+@property (nonatomic, copy) NSString *batchAction;
+@property (nonatomic, assign) LoaderRequestPriority priority;
+@property (nonatomic, assign) BOOL started;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, assign) NSUInteger retryCount;
+@property (nonatomic, assign) CFAbsoluteTime createdTime;
+@property (nonatomic, assign) CFAbsoluteTime startedTime;
+@property (nonatomic, assign) BOOL batched;
+@property (nonatomic, strong) NSMutableArray *waiters;
+- (void)addWaiterWithOwner:(AWFObjectLoader *)owner completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+@end
+
+@implementation LoaderRequest
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_waiters = [[NSMutableArray alloc] init];
+	}
+	return self;
+}
+
+- (void)addWaiterWithOwner:(AWFObjectLoader *)owner completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	LoaderRequestWaiter *waiter = [[LoaderRequestWaiter alloc] init];
+	waiter.owner = owner;
+	waiter.completionBlock = completionBlock;
+	[self.waiters addObject:waiter];
+}
+
+@end
+
+
+@interface LoaderRequestManager ()
+@property (nonatomic, strong) NSMutableDictionary *activeRequests;
+@property (nonatomic, strong) NSMutableArray *pendingBatchRequests;
+@property (nonatomic, strong) NSMutableSet *activeBatchLoaders;
+@property (nonatomic, strong) NSMutableArray *deferredRequests;
+@property (nonatomic, strong) NSMutableDictionary *endpointFailureCounts;
+@property (nonatomic, strong) NSMutableDictionary *endpointCircuitExpirations;
+@property (nonatomic, strong) NSMutableDictionary *endpointProbeKeys;
+- (void)requestWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options
+					  key:(NSString *)key expirationInterval:(NSTimeInterval)expirationInterval priority:(LoaderRequestPriority)priority
+			   completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+- (AWFRequestOptions *)optionsByApplyingProfiledFields:(AWFRequestOptions *)options forLoader:(AWFObjectLoader *)loader;
+- (BOOL)completeWithCachedObjectsForKey:(NSString *)key endpoint:(NSString *)endpoint expirationInterval:(NSTimeInterval)expirationInterval
+							 completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+- (void)requestWithKey:(NSString *)key loader:(AWFObjectLoader *)loader expirationInterval:(NSTimeInterval)expirationInterval priority:(LoaderRequestPriority)priority
+		   batchLoader:(AWFObjectLoader *)batchLoader batchAction:(NSString *)batchAction
+				 start:(LoaderRequestStartBlock)startBlock completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+- (void)scheduleRequest:(LoaderRequest *)request;
+- (BOOL)hasActiveVisibleRequests;
+- (void)scheduleDeferredRequestsIfNeeded;
+- (void)cancelRequest:(LoaderRequest *)request;
+- (void)observeOwnerLoader:(AWFObjectLoader *)loader;
+- (void)cancelRequestsWithoutOwners;
+- (void)startRequest:(LoaderRequest *)request;
+- (BOOL)isTransientError:(NSError *)error;
+- (NSHTTPURLResponse *)failingResponseForError:(NSError *)error;
+- (NSTimeInterval)retryAfterIntervalForError:(NSError *)error;
+- (void)retryRequest:(LoaderRequest *)request error:(NSError *)error;
+- (BOOL)isCircuitOpenForEndpoint:(NSString *)endpoint;
+- (BOOL)isProbeRequest:(LoaderRequest *)request;
+- (void)updateCircuitForRequest:(LoaderRequest *)request error:(NSError *)error;
+- (NSArray *)cachedObjectsWithinMaximumStaleAgeForKey:(NSString *)key expired:(BOOL *)expired;
+- (NSError *)unavailableEndpointError;
+- (void)completeWithUnavailableEndpointForKey:(NSString *)key completion:(AWFObjectLoaderCompletionBlock)completionBlock;
+- (void)flushBatchRequests;
+- (void)startBatchWithRequests:(NSArray *)requests;
+- (void)finishRequest:(LoaderRequest *)request objects:(NSArray *)objects error:(NSError *)error;
+- (AWFObjectLoader *)batchLoaderForLoader:(AWFObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options;
++ (NSString *)sortedQueryStringForOptions:(AWFRequestOptions *)options;
+@end
+
+static NSString *closestAction = @"closest";
+static NSString *batchKeyPrefix = @"request";
+
+static char ownerObserverKey;
+
+static NSString *retryAfterHeader = @"Retry-After";
+static NSString *retryAfterDateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+
+static NSUInteger defaultMaximumBatchSize = 10;
+static NSTimeInterval defaultMaximumStaleAge = 24 * 60 * 60;
+
+static NSUInteger defaultMaximumRetryCount = 2;
+static NSTimeInterval defaultRetryInterval = 1.0;
+static NSTimeInterval maximumRetryDelay = 10.0;
+static NSUInteger defaultCircuitBreakerThreshold = 5;
+static NSTimeInterval defaultCircuitBreakerInterval = 30.0;
+
+@implementation LoaderRequestManager
+
++ (LoaderRequestManager *)sharedManager {
+	static LoaderRequestManager *_sharedManager = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		_sharedManager = [[LoaderRequestManager alloc] init];
+	});
+
+	return _sharedManager;
+}
+
++ (NSString *)keyForEndpoint:(NSString *)endpoint action:(NSString *)action place:(AWFPlace *)place options:(AWFRequestOptions *)options {
+	NSString *placeString = ([place stringForQuery]) ? [[place stringForQuery] lowercaseString] : @"";
+	NSString *actionString = (action) ? action : @"";
+
+	return [NSString stringWithFormat:@"%@/%@/%@?%@", endpoint, actionString, placeString, [self sortedQueryStringForOptions:options]];
+}
+
++ (NSString *)keyForLoader:(AWFObjectLoader *)loader action:(NSString *)action place:(AWFPlace *)place options:(AWFRequestOptions *)options {
+	NSString *key = [self keyForEndpoint:loader.endpoint action:action place:place options:options];
+
+	// the loader's default options are sent along with the request options, so loaders with different defaults can't share
+	NSString *defaultQuery = [self sortedQueryStringForOptions:loader.options];
+	return ([defaultQuery length] > 0) ? [NSString stringWithFormat:@"%@#%@", key, defaultQuery] : key;
+}
+
+#pragma mark - Instance Methods
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_activeRequests = [[NSMutableDictionary alloc] init];
+		_pendingBatchRequests = [[NSMutableArray alloc] init];
+		_activeBatchLoaders = [[NSMutableSet alloc] init];
+		_deferredRequests = [[NSMutableArray alloc] init];
+		_endpointFailureCounts = [[NSMutableDictionary alloc] init];
+		_endpointCircuitExpirations = [[NSMutableDictionary alloc] init];
+		_endpointProbeKeys = [[NSMutableDictionary alloc] init];
+		_cache = [ResponseCache sharedCache];
+		_maximumBatchSize = defaultMaximumBatchSize;
+		_maximumStaleAge = defaultMaximumStaleAge;
+		_maximumRetryCount = defaultMaximumRetryCount;
+		_retryInterval = defaultRetryInterval;
+		_circuitBreakerThreshold = defaultCircuitBreakerThreshold;
+		_circuitBreakerInterval = defaultCircuitBreakerInterval;
+	}
+	return self;
+}
+
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	[self getWithLoader:loader place:place options:options expirationInterval:0 completion:completionBlock];
+}
+
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options expirationInterval:(NSTimeInterval)expirationInterval
+		   completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	[self getWithLoader:loader place:place options:options expirationInterval:expirationInterval priority:LoaderRequestPriorityVisible completion:completionBlock];
+}
+
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options expirationInterval:(NSTimeInterval)expirationInterval
+			 priority:(LoaderRequestPriority)priority completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	place = [self placeSnappedToGrid:place];
+	options = [self optionsByApplyingProfiledFields:options forLoader:loader];
+	NSString *key = [[self class] keyForLoader:loader action:nil place:place options:options];
+	if ([self completeWithCachedObjectsForKey:key endpoint:loader.endpoint expirationInterval:expirationInterval completion:completionBlock]) {
+		return;
+	}
+
+	[self requestWithLoader:loader place:place radius:nil options:options key:key expirationInterval:expirationInterval priority:priority completion:completionBlock];
+}
+
+- (void)getWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options expirationInterval:(NSTimeInterval)expirationInterval
+	  staleCompletion:(LoaderRequestStaleCompletionBlock)completionBlock {
+	place = [self placeSnappedToGrid:place];
+	options = [self optionsByApplyingProfiledFields:options forLoader:loader];
+	NSString *key = [[self class] keyForLoader:loader action:nil place:place options:options];
+
+	BOOL expired = NO;
+	NSArray *cachedObjects = [self cachedObjectsWithinMaximumStaleAgeForKey:key expired:&expired];
+
+	if (cachedObjects && !expired) {
+		[self.metrics addCacheHitForEndpoint:loader.endpoint];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(cachedObjects, NO, nil);
+		});
+		return;
+	}
+
+	// show the expired objects right away while fresh ones are requested
+	BOOL deliveredStale = (cachedObjects != nil);
+	NSString *staleDigest = nil;
+	if (deliveredStale) {
+		staleDigest = [self.cache digestForKey:key];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(cachedObjects, YES, nil);
+		});
+	}
+
+	// while the endpoint is unavailable the stale objects, if any, are all there is, so they're left showing as stale
+	if (![self.activeRequests objectForKey:key] && [self isCircuitOpenForEndpoint:loader.endpoint]) {
+		NSError *error = [self unavailableEndpointError];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(nil, deliveredStale, error);
+		});
+		return;
+	}
+
+	__weak typeof(self) weakSelf = self;
+	[self requestWithLoader:loader place:place radius:nil options:options key:key expirationInterval:expirationInterval priority:LoaderRequestPriorityVisible completion:^(NSArray *objects, NSError *error) {
+		if (!deliveredStale) {
+			completionBlock(objects, NO, error);
+			return;
+		}
+
+		// the caller is showing the stale objects, so let it know they couldn't be refreshed
+		if (error) {
+			completionBlock(nil, YES, error);
+			return;
+		}
+
+		// otherwise only call back again if the data actually changed, comparing against the new entry once the cache has
+		// stored it rather than waiting for that here
+		ResponseCache *cache = weakSelf.cache;
+		if (!staleDigest || !cache) {
+			completionBlock(objects, NO, nil);
+			return;
+		}
+
+		[cache digestForKey:key completion:^(NSString *digest) {
+			if (![staleDigest isEqualToString:digest]) {
+				completionBlock(objects, NO, nil);
+			}
+		}];
+	}];
+}
+
+- (void)getClosestWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	[self getClosestWithLoader:loader place:place radius:radius options:options expirationInterval:0 completion:completionBlock];
+}
+
+- (void)getClosestWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options
+		  expirationInterval:(NSTimeInterval)expirationInterval completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	place = [self placeSnappedToGrid:place];
+	options = [self optionsByApplyingProfiledFields:options forLoader:loader];
+	NSString *action = [NSString stringWithFormat:@"%@:%@", closestAction, (radius) ? radius : @""];
+	NSString *key = [[self class] keyForLoader:loader action:action place:place options:options];
+	if ([self completeWithCachedObjectsForKey:key endpoint:loader.endpoint expirationInterval:expirationInterval completion:completionBlock]) {
+		return;
+	}
+
+	[self requestWithLoader:loader place:place radius:radius options:options key:key expirationInterval:expirationInterval priority:LoaderRequestPriorityVisible completion:completionBlock];
+}
+
+- (void)cancelRequestsForLoader:(AWFObjectLoader *)loader {
+	[[self.activeRequests allValues] enumerateObjectsUsingBlock:^(LoaderRequest *request, NSUInteger idx, BOOL *stop) {
+		NSIndexSet *indexes = [request.waiters indexesOfObjectsPassingTest:^BOOL(LoaderRequestWaiter *waiter, NSUInteger idx, BOOL *stop) {
+			return (waiter.owner == loader);
+		}];
+		[request.waiters removeObjectsAtIndexes:indexes];
+
+		// only cancel the request itself once nobody else is waiting on it
+		if ([indexes count] > 0 && [request.waiters count] == 0) {
+			[self cancelRequest:request];
+		}
+	}];
+
+	[self scheduleDeferredRequestsIfNeeded];
+}
+
+- (AWFPlace *)placeSnappedToGrid:(AWFPlace *)place {
+	CLLocationDegrees size = self.coordinateGridSize;
+	if (size <= 0 || !place.latitude || !place.longitude || [place.name length] > 0 || [place.zipcode length] > 0) {
+		return place;
+	}
+
+	CLLocationDegrees latitude = (floor([place.latitude doubleValue] / size) + 0.5) * size;
+	CLLocationDegrees longitude = (floor([place.longitude doubleValue] / size) + 0.5) * size;
+
+	return [AWFPlace placeWithLatitude:MAX(-90.0, MIN(90.0, latitude)) longitude:MAX(-180.0, MIN(180.0, longitude))];
+}
+
+- (NSString *)keyForRequestWithLoader:(AWFObjectLoader *)loader place:(AWFPlace *)place options:(AWFRequestOptions *)options {
+	return [[self class] keyForLoader:loader action:nil place:[self placeSnappedToGrid:place] options:[self optionsByApplyingProfiledFields:options forLoader:loader]];
+}
+
+#pragma mark - Private
+
+- (void)requestWithLoader:(AWFGeographicObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options
+					  key:(NSString *)key expirationInterval:(NSTimeInterval)expirationInterval priority:(LoaderRequestPriority)priority
+			   completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	if (![self.activeRequests objectForKey:key]) {
+		if ([self isCircuitOpenForEndpoint:loader.endpoint]) {
+			[self completeWithUnavailableEndpointForKey:key completion:completionBlock];
+			return;
+		}
+
+		// the circuit is half open, so this request tests the endpoint while all others are still turned away
+		if ([self.endpointCircuitExpirations objectForKey:loader.endpoint]) {
+			[self.endpointProbeKeys setObject:key forKey:loader.endpoint];
+		}
+	}
+
+	AWFObjectLoader *batchLoader = (self.batchInterval > 0) ? [self batchLoaderForLoader:loader place:place radius:radius options:options] : nil;
+
+	// a radius means the request is for the closest results rather than the place itself
+	if (radius) {
+		[self requestWithKey:key loader:loader expirationInterval:expirationInterval priority:priority batchLoader:batchLoader batchAction:AerisAPIActionClosest start:^(AWFObjectLoader *requestLoader, AWFObjectLoaderCompletionBlock requestCompletionBlock) {
+			[requestLoader getClosestToPlace:place radius:radius options:options completion:requestCompletionBlock];
+		} completion:completionBlock];
+	}
+	else {
+		[self requestWithKey:key loader:loader expirationInterval:expirationInterval priority:priority batchLoader:batchLoader batchAction:nil start:^(AWFObjectLoader *requestLoader, AWFObjectLoaderCompletionBlock requestCompletionBlock) {
+			[requestLoader getForPlace:place options:options completion:requestCompletionBlock];
+		} completion:completionBlock];
+	}
+}
+
+- (AWFRequestOptions *)optionsByApplyingProfiledFields:(AWFRequestOptions *)options forLoader:(AWFObjectLoader *)loader {
+	if (!self.appliesProfiledFields || [options.fields length] > 0) {
+		return options;
+	}
+
+	NSString *fields = [[FieldUsageProfiler sharedProfiler] fieldsForObjectClass:loader.objectClass];
+	if (!fields) {
+		return options;
+	}
+
+	// work from a copy so the caller's options aren't modified
+	AWFRequestOptions *profiledOptions = (options) ? [AWFRequestOptions requestOptionsFromDictionary:[options optionsAsDictionary]] : [AWFRequestOptions options];
+	profiledOptions.fields = fields;
+
+	return profiledOptions;
+}
+
+- (BOOL)completeWithCachedObjectsForKey:(NSString *)key endpoint:(NSString *)endpoint expirationInterval:(NSTimeInterval)expirationInterval
+							 completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	if (expirationInterval <= 0 || !self.cache) {
+		return NO;
+	}
+
+	NSArray *objects = [self.cache objectsForKey:key];
+	if (!objects) {
+		return NO;
+	}
+
+	[self.metrics addCacheHitForEndpoint:endpoint];
+
+	// always call back asynchronously so callers see the same ordering as a network request
+	if (completionBlock) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(objects, nil);
+		});
+	}
+
+	return YES;
+}
+
+- (void)requestWithKey:(NSString *)key loader:(AWFObjectLoader *)loader expirationInterval:(NSTimeInterval)expirationInterval priority:(LoaderRequestPriority)priority
+		   batchLoader:(AWFObjectLoader *)batchLoader batchAction:(NSString *)batchAction
+				 start:(LoaderRequestStartBlock)startBlock completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	// without a loader there's nothing to load with, and a waiter without an owner would be dropped right away
+	if (!loader || !key) {
+		return;
+	}
+
+	LoaderRequest *request = [self.activeRequests objectForKey:key];
+
+	// an identical request is already in progress, so just wait for its results
+	if (request) {
+		request.expirationInterval = MAX(request.expirationInterval, expirationInterval);
+		[request addWaiterWithOwner:loader completion:completionBlock];
+		[self observeOwnerLoader:loader];
+
+		// a deferred background request needs to go out right away once something visible is waiting on it
+		if (priority > request.priority) {
+			request.priority = priority;
+			if ([self.deferredRequests containsObject:request]) {
+				[self.deferredRequests removeObject:request];
+				[self scheduleRequest:request];
+			}
+		}
+		return;
+	}
+
+	request = [[LoaderRequest alloc] init];
+	request.key = key;
+	request.endpoint = loader.endpoint;
+	request.expirationInterval = expirationInterval;
+	// load with a copy so cancelling the request never cancels something else the caller's loader is doing, and the request
+	// doesn't keep the caller's loader alive
+	request.loader = [loader copy];
+	request.startBlock = startBlock;
+	request.batchLoader = batchLoader;
+	request.batchAction = batchAction;
+	request.priority = priority;
+	request.createdTime = CFAbsoluteTimeGetCurrent();
+	[request addWaiterWithOwner:loader completion:completionBlock];
+	[self observeOwnerLoader:loader];
+	[self.activeRequests setObject:request forKey:key];
+
+	[self scheduleRequest:request];
+}
+
+- (void)scheduleRequest:(LoaderRequest *)request {
+	// hold background requests until the visible ones have finished so they don't compete for the connection
+	if (request.priority < LoaderRequestPriorityVisible && [self hasActiveVisibleRequests]) {
+		[self.deferredRequests addObject:request];
+		return;
+	}
+
+	if (self.batchInterval <= 0 || !request.batchLoader) {
+		[self startRequest:request];
+		return;
+	}
+
+	// hold the request until the batch window closes so it can be combined with any others made in the meantime
+	[self.pendingBatchRequests addObject:request];
+	if ([self.pendingBatchRequests count] == 1) {
+		[self performSelector:@selector(flushBatchRequests) withObject:nil afterDelay:self.batchInterval];
+	}
+}
+
+- (BOOL)hasActiveVisibleRequests {
+	for (LoaderRequest *request in [self.activeRequests allValues]) {
+		if (request.priority == LoaderRequestPriorityVisible) {
+			return YES;
+		}
+	}
+	return NO;
+}
+
+- (void)scheduleDeferredRequestsIfNeeded {
+	if ([self.deferredRequests count] == 0 || [self hasActiveVisibleRequests]) {
+		return;
+	}
+
+	NSArray *requests = [self.deferredRequests copy];
+	[self.deferredRequests removeAllObjects];
+
+	[requests enumerateObjectsUsingBlock:^(LoaderRequest *request, NSUInteger idx, BOOL *stop) {
+		[self scheduleRequest:request];
+	}];
+}
+
+- (void)cancelRequest:(LoaderRequest *)request {
+	request.cancelled = YES;
+
+	// let the next request test the endpoint instead
+	if ([self isProbeRequest:request]) {
+		[self.endpointProbeKeys removeObjectForKey:request.endpoint];
+	}
+
+	if ([self.activeRequests objectForKey:request.key] == request) {
+		[self.activeRequests removeObjectForKey:request.key];
+	}
+	[self.pendingBatchRequests removeObject:request];
+	[self.deferredRequests removeObject:request];
+
+	// requests sent as part of a batch can't be cancelled individually, so their results are just ignored
+	if (request.started && !request.batchLoader) {
+		[request.loader cancel];
+	}
+
+	[request.waiters removeAllObjects];
+	request.loader = nil;
+	request.startBlock = nil;
+	request.batchLoader = nil;
+}
+
+- (void)observeOwnerLoader:(AWFObjectLoader *)loader {
+	if (!loader || objc_getAssociatedObject(loader, &ownerObserverKey)) {
+		return;
+	}
+
+	// the observer is released along with the loader, which is the only notice we get that nothing is left to deliver to
+	LoaderRequestOwnerObserver *observer = [[LoaderRequestOwnerObserver alloc] init];
+	__weak typeof(self) weakSelf = self;
+	observer.deallocBlock = ^{
+		dispatch_async(dispatch_get_main_queue(), ^{
+			[weakSelf cancelRequestsWithoutOwners];
+		});
+	};
+	objc_setAssociatedObject(loader, &ownerObserverKey, observer, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+- (void)cancelRequestsWithoutOwners {
+	[[self.activeRequests allValues] enumerateObjectsUsingBlock:^(LoaderRequest *request, NSUInteger idx, BOOL *stop) {
+		NSIndexSet *indexes = [request.waiters indexesOfObjectsPassingTest:^BOOL(LoaderRequestWaiter *waiter, NSUInteger idx, BOOL *stop) {
+			return (waiter.owner == nil);
+		}];
+		[request.waiters removeObjectsAtIndexes:indexes];
+
+		if ([request.waiters count] == 0) {
+			[self cancelRequest:request];
+		}
+	}];
+
+	[self scheduleDeferredRequestsIfNeeded];
+}
+
+- (void)startRequest:(LoaderRequest *)request {
+	if (!request.started) {
+		request.startedTime = CFAbsoluteTimeGetCurrent();
+	}
+	request.started = YES;
+	request.batchLoader = nil;
+
+	__weak typeof(self) weakSelf = self;
+	request.startBlock(request.loader, ^(NSArray *objects, NSError *error) {
+		[weakSelf finishRequest:request objects:objects error:error];
+	});
+}
+
+- (BOOL)isTransientError:(NSError *)error {
+	// server errors and rate limiting should clear up on their own, while other statuses such as an invalid place will
+	// fail the same way every time
+	NSHTTPURLResponse *response = [self failingResponseForError:error];
+	if (response) {
+		return (response.statusCode >= 500 || response.statusCode == 429);
+	}
+
+	if (![error.domain isEqualToString:NSURLErrorDomain]) {
+		NSError *underlyingError = [error.userInfo objectForKey:NSUnderlyingErrorKey];
+		return (underlyingError) ? [self isTransientError:underlyingError] : NO;
+	}
+
+	switch (error.code) {
+		case NSURLErrorTimedOut:
+		case NSURLErrorCannotFindHost:
+		case NSURLErrorCannotConnectToHost:
+		case NSURLErrorNetworkConnectionLost:
+		case NSURLErrorDNSLookupFailed:
+			return YES;
+		default:
+			return NO;
+	}
+}
+
+- (NSHTTPURLResponse *)failingResponseForError:(NSError *)error {
+	// AFNetworking attaches the response to the errors for unacceptable statuses, which may be wrapped by the loader
+	for (NSError *currentError = error; currentError; currentError = [currentError.userInfo objectForKey:NSUnderlyingErrorKey]) {
+		id response = [currentError.userInfo objectForKey:AFNetworkingOperationFailingURLResponseErrorKey];
+		if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+			return response;
+		}
+	}
+	return nil;
+}
+
+- (NSTimeInterval)retryAfterIntervalForError:(NSError *)error {
+	NSString *value = [[[self failingResponseForError:error] allHeaderFields] objectForKey:retryAfterHeader];
+	if ([value length] == 0) {
+		return 0;
+	}
+
+	// the header is either a number of seconds or an HTTP date
+	NSScanner *scanner = [NSScanner scannerWithString:value];
+	NSInteger seconds = 0;
+	if ([scanner scanInteger:&seconds] && [scanner isAtEnd]) {
+		return MAX(seconds, 0);
+	}
+
+	NSDateFormatter *formatter = [DateFormatterCache formatterWithFormat:retryAfterDateFormat timeZone:[NSTimeZone timeZoneWithAbbreviation:@"GMT"]
+																  locale:[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"]];
+	NSDate *date = [formatter dateFromString:value];
+	return (date) ? MAX([date timeIntervalSinceNow], 0) : 0;
+}
+
+- (void)retryRequest:(LoaderRequest *)request error:(NSError *)error {
+	// exponential backoff with jitter so that requests that failed together are spread out when they retry, but never
+	// sooner than the server asked
+	NSTimeInterval interval = self.retryInterval * pow(2, request.retryCount);
+	NSTimeInterval delay = interval / 2 + (interval / 2) * (arc4random_uniform(1000) / 1000.0);
+	delay = MIN(MAX(delay, [self retryAfterIntervalForError:error]), maximumRetryDelay);
+	request.retryCount++;
+
+	__weak typeof(self) weakSelf = self;
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+		if (!request.cancelled) {
+			[weakSelf startRequest:request];
+		}
+	});
+}
+
+- (BOOL)isCircuitOpenForEndpoint:(NSString *)endpoint {
+	NSDate *expiration = [self.endpointCircuitExpirations objectForKey:endpoint];
+	if (!expiration) {
+		return NO;
+	}
+
+	// once the interval has passed the circuit is half open, which only stays open while a request is testing the endpoint
+	return ([expiration timeIntervalSinceNow] > 0 || [self.endpointProbeKeys objectForKey:endpoint] != nil);
+}
+
+- (BOOL)isProbeRequest:(LoaderRequest *)request {
+	return (request.endpoint && [[self.endpointProbeKeys objectForKey:request.endpoint] isEqualToString:request.key]);
+}
+
+- (void)updateCircuitForRequest:(LoaderRequest *)request error:(NSError *)error {
+	NSString *endpoint = request.endpoint;
+	if (!endpoint) {
+		return;
+	}
+
+	BOOL probe = [self isProbeRequest:request];
+	if (probe) {
+		[self.endpointProbeKeys removeObjectForKey:endpoint];
+	}
+
+	// any response other than a transient failure means the endpoint is reachable again
+	if (!error || ![self isTransientError:error]) {
+		[self.endpointFailureCounts removeObjectForKey:endpoint];
+		[self.endpointCircuitExpirations removeObjectForKey:endpoint];
+		return;
+	}
+
+	NSUInteger failures = [[self.endpointFailureCounts objectForKey:endpoint] unsignedIntegerValue] + 1;
+	[self.endpointFailureCounts setObject:@(failures) forKey:endpoint];
+
+	// a server asking for a longer wait than a retry is held for opens the circuit right away since it's unavailable until then
+	NSTimeInterval retryAfterInterval = [self retryAfterIntervalForError:error];
+	if (self.circuitBreakerThreshold > 0 && (probe || failures >= self.circuitBreakerThreshold || retryAfterInterval > maximumRetryDelay)) {
+		NSTimeInterval interval = MAX(self.circuitBreakerInterval, retryAfterInterval);
+		[self.endpointCircuitExpirations setObject:[NSDate dateWithTimeIntervalSinceNow:interval] forKey:endpoint];
+	}
+}
+
+- (NSArray *)cachedObjectsWithinMaximumStaleAgeForKey:(NSString *)key expired:(BOOL *)expired {
+	BOOL isExpired = NO;
+	NSArray *objects = [self.cache objectsForKey:key includingExpired:YES expired:&isExpired];
+
+	// objects stored too long ago are treated as missing rather than shown as if they were still current
+	if (objects && isExpired && self.maximumStaleAge > 0) {
+		NSDate *storedDate = [self.cache storedDateForKey:key];
+		if (!storedDate || -[storedDate timeIntervalSinceNow] > self.maximumStaleAge) {
+			objects = nil;
+		}
+	}
+
+	if (expired) {
+		*expired = isExpired;
+	}
+
+	return objects;
+}
+
+- (NSError *)unavailableEndpointError {
+	return [NSError errorWithDomain:LoaderRequestManagerErrorDomain
+							   code:LoaderRequestManagerErrorCodeEndpointUnavailable
+						   userInfo:@{NSLocalizedDescriptionKey: NSLocalizedString(@"The service is temporarily unavailable.", nil)}];
+}
+
+- (void)completeWithUnavailableEndpointForKey:(NSString *)key completion:(AWFObjectLoaderCompletionBlock)completionBlock {
+	if (!completionBlock) {
+		return;
+	}
+
+	// serve whatever was last loaded, even if expired, since it's better than nothing while the endpoint is failing
+	NSArray *objects = [self cachedObjectsWithinMaximumStaleAgeForKey:key expired:NULL];
+	NSError *error = (objects) ? nil : [self unavailableEndpointError];
+
+	dispatch_async(dispatch_get_main_queue(), ^{
+		completionBlock(objects, error);
+	});
+}
+
+- (void)flushBatchRequests {
+	NSArray *requests = [self.pendingBatchRequests copy];
+	[self.pendingBatchRequests removeAllObjects];
+
+	// the batch endpoint only accepts a limited number of requests, so larger groups are split across several batches
+	NSUInteger batchSize = MAX(self.maximumBatchSize, 1);
+	for (NSUInteger location = 0; location < [requests count]; location += batchSize) {
+		NSRange range = NSMakeRange(location, MIN(batchSize, [requests count] - location));
+		[self startBatchWithRequests:[requests subarrayWithRange:range]];
+	}
+}
+
+- (void)startBatchWithRequests:(NSArray *)requests {
+	if ([requests count] == 1) {
+		[self startRequest:[requests firstObject]];
+		return;
+	}
+
+	AWFBatchLoader *batchLoader = [[AWFBatchLoader alloc] init];
+	[requests enumerateObjectsUsingBlock:^(LoaderRequest *request, NSUInteger idx, BOOL *stop) {
+		NSString *batchKey = [NSString stringWithFormat:@"%@%lu", batchKeyPrefix, (unsigned long)idx];
+		if (request.batchAction) {
+			[batchLoader addLoader:request.batchLoader action:request.batchAction forKey:batchKey];
+		}
+		else {
+			[batchLoader addLoader:request.batchLoader forKey:batchKey];
+		}
+		request.started = YES;
+		request.startedTime = CFAbsoluteTimeGetCurrent();
+		request.batched = YES;
+	}];
+
+	// keep the batch loader around until it completes since none of the requests own it
+	[self.activeBatchLoaders addObject:batchLoader];
+
+	__weak typeof(self) weakSelf = self;
+	[batchLoader getWithCompletionBlock:^(AWFBatchLoader *loader, NSError *error) {
+		[weakSelf.activeBatchLoaders removeObject:loader];
+		[requests enumerateObjectsUsingBlock:^(LoaderRequest *request, NSUInteger idx, BOOL *stop) {
+			NSString *batchKey = [NSString stringWithFormat:@"%@%lu", batchKeyPrefix, (unsigned long)idx];
+			NSArray *objects = (error) ? nil : [loader objectsForLoaderWithKey:batchKey];
+
+			// the batch loader doesn't expose the error for each request, only that it has no objects, so send those requests
+			// on their own to deliver the same objects or error that an unbatched request would have
+			if (!error && !objects && !request.cancelled) {
+				[weakSelf startRequest:request];
+				return;
+			}
+
+			[weakSelf finishRequest:request objects:objects error:error];
+		}];
+	}];
+}
+
+- (void)finishRequest:(LoaderRequest *)request objects:(NSArray *)objects error:(NSError *)error {
+	if (request.cancelled) {
+		return;
+	}
+
+	// loader requests are all GETs, so it's always safe to send them again after a transient failure, except for a request
+	// testing an open circuit, which reopens it right away instead. A server asking for a longer wait than a retry is held
+	// for fails the request so the circuit breaker can keep the endpoint closed that long rather than the request waiting.
+	if (error && request.retryCount < self.maximumRetryCount && ![self isProbeRequest:request] && [self isTransientError:error]
+		&& [self retryAfterIntervalForError:error] <= maximumRetryDelay) {
+		[self retryRequest:request error:error];
+		return;
+	}
+
+	[self updateCircuitForRequest:request error:error];
+
+	// remove the request before calling any completion blocks so they can safely start a new identical request
+	if ([self.activeRequests objectForKey:request.key] == request) {
+		[self.activeRequests removeObjectForKey:request.key];
+	}
+
+	if (!error && objects && request.expirationInterval > 0) {
+		[self.cache setObjects:objects forKey:request.key endpoint:request.endpoint expirationInterval:request.expirationInterval];
+	}
+
+	// taken after handing the objects to the cache so the dispatch duration only covers the completion blocks
+	CFAbsoluteTime loadedTime = CFAbsoluteTimeGetCurrent();
+
+	NSArray *waiters = [request.waiters copy];
+	[request.waiters removeAllObjects];
+	request.loader = nil;
+	request.startBlock = nil;
+	request.batchLoader = nil;
+
+	// skip callers whose loader has been deallocated since there's nothing left to deliver the objects to
+	[waiters enumerateObjectsUsingBlock:^(LoaderRequestWaiter *waiter, NSUInteger idx, BOOL *stop) {
+		if (waiter.owner && waiter.completionBlock) {
+			waiter.completionBlock(objects, error);
+		}
+	}];
+
+	if (self.metrics) {
+		RequestMetricsRecord *record = [[RequestMetricsRecord alloc] init];
+		record.endpoint = request.endpoint;
+		record.key = request.key;
+		record.queueDuration = request.startedTime - request.createdTime;
+		record.loadDuration = loadedTime - request.startedTime;
+		record.dispatchDuration = CFAbsoluteTimeGetCurrent() - loadedTime;
+		record.retryCount = request.retryCount;
+		record.batched = request.batched;
+		record.failed = (error != nil);
+		[self.metrics addRecord:record];
+	}
+
+	[self scheduleDeferredRequestsIfNeeded];
+}
+
+- (AWFObjectLoader *)batchLoaderForLoader:(AWFObjectLoader *)loader place:(AWFPlace *)place radius:(NSString *)radius options:(AWFRequestOptions *)options {
+	// batched requests are configured entirely through the loader's options, so merge the request options over a copy of
+	// the loader's defaults rather than replacing them
+	NSMutableDictionary *optionsDictionary = [NSMutableDictionary dictionaryWithDictionary:[loader.options optionsAsDictionary]];
+	[optionsDictionary addEntriesFromDictionary:[options optionsAsDictionary]];
+	AWFRequestOptions *batchOptions = ([optionsDictionary count] > 0) ? [AWFRequestOptions requestOptionsFromDictionary:optionsDictionary] : [AWFRequestOptions options];
+	batchOptions.place = place;
+
+	if (radius) {
+		if ([[radius lowercaseString] hasSuffix:@"km"]) {
+			batchOptions.radiusKM = [radius integerValue];
+		}
+		else {
+			batchOptions.radiusMI = [radius integerValue];
+		}
+	}
+
+	AWFObjectLoader *batchLoader = [loader copy];
+	batchLoader.options = batchOptions;
+
+	return batchLoader;
+}
+
++ (NSString *)sortedQueryStringForOptions:(AWFRequestOptions *)options {
+	NSMutableArray *components = [[NSMutableArray alloc] init];
+
+	// sort the query components so the key doesn't depend on the order the options were set in
+	NSString *query = [options optionsAsQueryStringIgnoringPlace];
+	[[query componentsSeparatedByString:@"&"] enumerateObjectsUsingBlock:^(NSString *component, NSUInteger idx, BOOL *stop) {
+		if ([component length] > 0) {
+			[components addObject:component];
+		}
+	}];
+	[components sortUsingSelector:@selector(compare:)];
+
+	return [components componentsJoinedByString:@"&"];
+}
+
+@end
@@ -13,6 +13,7 @@ extern NSString * const kAWFDemoDefaultPlaceChanged = @"AWFDemoDefaultPlaceChang
 @interface LocationSearchViewController ()
 @property (nonatomic, strong) UITableView *tableView;
 @property (nonatomic, strong) AWFPlacesLoader *placesLoader;
+@property (nonatomic, strong) AWFPlacesLoader *nearbyPlacesLoader;
 @property (nonatomic, strong) NSArray *results;
 @property (nonatomic, strong) NSArray *geoResults;
 @property (nonatomic, strong) NSMutableArray *searchResults;
@@ -22,6 +23,7 @@ extern NSString * const kAWFDemoDefaultPlaceChanged = @"AWFDemoDefaultPlaceChang
 @end
 
 static NSString *cellIdentifier = @"LocationCellIdentifier";
+static NSTimeInterval placesExpirationInterval = 60 * 60;
 
 @implementation LocationSearchViewController
 
@@ -29,6 +31,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
     self = [super initWithNibName:nibNameOrNil bundle:nibBundleOrNil];
     if (self) {
         self.placesLoader = [[AWFPlacesLoader alloc] init];
+		self.nearbyPlacesLoader = [[AWFPlacesLoader alloc] init];
 		self.searchResults = [[NSMutableArray alloc] init];
     }
     return self;
@@ -82,7 +85,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 	__weak typeof(self) weakSelf = self;
 	[AWFPlace getCurrentLocationWithCompletion:^(AWFPlace *place, NSError *error) {
 		if (error) {
-			NSLog(@"Failed to get current location! %@", error);
+			AppLogError(@"Failed to get current location! %@", error);
 			return;
 		}
 		
@@ -90,9 +93,11 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 		options.limit = 25;
 		//options.filter = @"poi";
 		
-		[weakSelf.placesLoader getClosestToPlace:place radius:@"10mi" options:options completion:^(NSArray *objects, NSError *error) {
+		// nearby places rarely change, so a location within the same grid cell as a recent search is served from the cache
+		[[LoaderRequestManager sharedManager] getClosestWithLoader:weakSelf.nearbyPlacesLoader place:place radius:@"10mi" options:options
+												expirationInterval:placesExpirationInterval completion:^(NSArray *objects, NSError *error) {
 			if (error) {
-				NSLog(@"Failed to get place from current location! %@", error);
+				AppLogError(@"Failed to get place from current location! %@", error);
 				return;
 			}
 			
@@ -117,7 +122,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 		
 		[self.placesLoader getClosestToPlace:place radius:@"50mi" options:options completion:^(NSArray *objects, NSError *error) {
 			if (error) {
-				NSLog(@"Places search based on coordinate failed! %@", error);
+				AppLogError(@"Places search based on coordinate failed! %@", error);
 				return;
 			}
 			
@@ -129,7 +134,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 		NSString *zipcode = [searchValue stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
 		[self.placesLoader searchForPlaceWithZipcode:zipcode options:options completion:^(NSArray *objects, NSError *error) {
 			if (error) {
-				NSLog(@"Places search based on zip code failed! %@", error);
+				AppLogError(@"Places search based on zip code failed! %@", error);
 				return;
 			}
 			
@@ -147,7 +152,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 			// do a "starts with" search since it's just a name
 			[self.placesLoader searchForPlaceWithNameStartingWith:[searchValue lowercaseString] options:options completion:^(NSArray *objects, NSError *error) {
 				if (error) {
-					NSLog(@"Places search based on name starts with failed! %@", error);
+					AppLogError(@"Places search based on name starts with failed! %@", error);
 					return;
 				}
 				
@@ -172,7 +177,7 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 											  options:options completion:^(NSArray *objects, NSError *error)
 			{
 				if (error) {
-					NSLog(@"Places search based on name failed! %@", error);
+					AppLogError(@"Places search based on name failed! %@", error);
 					return;
 				}
 				
@@ -340,6 +345,9 @@ static NSString *cellIdentifier = @"LocationCellIdentifier";
 
 - (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText {
 	if (searchText.length >= 3) {
+		// the nearby search goes through the request manager, which may be sharing it, so it's cancelled there while the
+		// text searches are made with their own loader directly
+		[[LoaderRequestManager sharedManager] cancelRequestsForLoader:self.nearbyPlacesLoader];
 		[self.placesLoader cancel];
 		[self searchWithString:searchText];
 	}
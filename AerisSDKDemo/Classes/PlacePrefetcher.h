@@ -0,0 +1,74 @@
+//
+//  PlacePrefetcher.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `PlacePrefetcher` keeps the cached data for a list of places warm so that switching between them can be served from
+ *  `ResponseCache` instead of waiting on new requests. Each place is requested with every registered loader whenever its
+ *  cached data has expired, using background priority requests through `LoaderRequestManager` so they only go out once
+ *  the visible requests have finished and are combined into batch requests.
+ *
+ *  Once started, a refresh runs periodically while the app is active and once more when it enters the background. Refreshes
+ *  stop for the rest of the budget interval once the cache budget has been used.
+ *
+ *  All methods must be called from the main thread.
+ */
+@interface PlacePrefetcher : NSObject
+
+/**
+ *  The places to keep warm. Defaults to `nil`, in which case the saved locations from `UserLocationsManager` are used.
+ */
+@property (nonatomic, copy) NSArray *places;
+
+/**
+ *  The duration, in seconds, between refreshes while the app is active. Defaults to 15 minutes.
+ */
+@property (nonatomic, assign) NSTimeInterval refreshInterval;
+
+/**
+ *  The maximum number of bytes that refreshes can add to the cache within the budget interval. This is measured by the size
+ *  of the stored cache entries, which are more compact than the API responses, so it limits the cache space used rather
+ *  than the exact network usage. A value of `0` removes the limit. Defaults to 1 MB.
+ */
+@property (nonatomic, assign) unsigned long long cacheBudget;
+
+/**
+ *  The duration, in seconds, after which the bytes counted against the budget are reset. Defaults to 24 hours.
+ */
+@property (nonatomic, assign) NSTimeInterval budgetInterval;
+
+/**
+ *  The number of bytes of cache entries stored by refreshes within the current budget interval.
+ */
+@property (readonly, nonatomic) unsigned long long cachedBytesUsed;
+
+/**
+ *  Adds a loader to request data for each place with. The options and expiration interval must match those used by the
+ *  view controllers that display the data so that their requests are served by the same cache entries.
+ *
+ *  @param loader             The object loader to request data with.
+ *  @param options            The request options, or `nil` to use the loader's defaults.
+ *  @param expirationInterval The duration, in seconds, that loaded objects remain valid in the cache.
+ */
+- (void)addLoader:(AWFGeographicObjectLoader *)loader options:(AWFRequestOptions *)options expirationInterval:(NSTimeInterval)expirationInterval;
+
+/**
+ *  Starts refreshing periodically and when the app enters the background, beginning with an initial refresh a few seconds
+ *  after being started.
+ */
+- (void)start;
+- (void)stop;
+
+/**
+ *  Requests data for every place whose cached data has expired, unless a refresh is already in progress or the cache
+ *  budget has been used.
+ */
+- (void)refresh;
+
+@end
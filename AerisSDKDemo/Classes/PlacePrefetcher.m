@@ -0,0 +1,159 @@
+//
+//  PlacePrefetcher.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "PlacePrefetcher.h"
+#import "ResponseCache.h"
+
+@interface PlacePrefetchLoader : NSObject
+@property (nonatomic, strong) AWFGeographicObjectLoader *loader;
+@property (nonatomic, strong) AWFRequestOptions *options;
+@property (nonatomic, assign) NSTimeInterval expirationInterval;
+@end
+
+@implementation PlacePrefetchLoader
+@end
+
+
+@interface PlacePrefetcher ()
+@property (nonatomic, strong) NSMutableArray *prefetchLoaders;
+@property (nonatomic, strong) NSTimer *refreshTimer;
+@property (nonatomic, strong) NSDate *budgetStartDate;
+@property (nonatomic, assign) unsigned long long cachedBytesUsed;
+@property (nonatomic, assign) NSUInteger outstandingRequests;
+@property (nonatomic, assign) UIBackgroundTaskIdentifier backgroundTask;
+- (BOOL)hasBudgetRemaining;
+- (void)finishRefreshIfNeeded;
+- (void)applicationDidEnterBackground:(NSNotification *)notification;
+@end
+
+static NSTimeInterval defaultRefreshInterval = 15 * 60;
+static unsigned long long defaultCacheBudget = 1024 * 1024;
+static NSTimeInterval defaultBudgetInterval = 24 * 60 * 60;
+static NSTimeInterval initialRefreshDelay = 5.0;
+
+@implementation PlacePrefetcher
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_prefetchLoaders = [[NSMutableArray alloc] init];
+		_refreshInterval = defaultRefreshInterval;
+		_cacheBudget = defaultCacheBudget;
+		_budgetInterval = defaultBudgetInterval;
+		_backgroundTask = UIBackgroundTaskInvalid;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[self stop];
+}
+
+- (void)addLoader:(AWFGeographicObjectLoader *)loader options:(AWFRequestOptions *)options expirationInterval:(NSTimeInterval)expirationInterval {
+	PlacePrefetchLoader *prefetchLoader = [[PlacePrefetchLoader alloc] init];
+	prefetchLoader.loader = loader;
+	prefetchLoader.options = options;
+	prefetchLoader.expirationInterval = expirationInterval;
+	[self.prefetchLoaders addObject:prefetchLoader];
+}
+
+- (void)start {
+	[self stop];
+
+	[[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+	self.refreshTimer = [NSTimer scheduledTimerWithTimeInterval:self.refreshInterval target:self selector:@selector(refresh) userInfo:nil repeats:YES];
+
+	// give the requests for the first screen a head start since the initial refresh is usually started during launch
+	[self performSelector:@selector(refresh) withObject:nil afterDelay:initialRefreshDelay];
+}
+
+- (void)stop {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(refresh) object:nil];
+	[[NSNotificationCenter defaultCenter] removeObserver:self name:UIApplicationDidEnterBackgroundNotification object:nil];
+	[self.refreshTimer invalidate];
+	self.refreshTimer = nil;
+}
+
+- (void)refresh {
+	if (self.outstandingRequests > 0) {
+		return;
+	}
+	else if (!self.hasBudgetRemaining) {
+		// nothing will be requested, so end any background task started for this refresh now
+		[self finishRefreshIfNeeded];
+		return;
+	}
+
+	LoaderRequestManager *manager = [LoaderRequestManager sharedManager];
+	NSArray *places = (self.places) ? self.places : [UserLocationsManager sharedManager].locations;
+
+	for (AWFPlace *place in places) {
+		for (PlacePrefetchLoader *prefetchLoader in self.prefetchLoaders) {
+			NSString *key = [manager keyForRequestWithLoader:prefetchLoader.loader place:place options:prefetchLoader.options];
+			if ([manager.cache hasObjectsForKey:key]) {
+				continue;
+			}
+			else if (!self.hasBudgetRemaining) {
+				break;
+			}
+
+			self.outstandingRequests++;
+
+			__weak typeof(self) weakSelf = self;
+			[manager getWithLoader:prefetchLoader.loader place:place options:prefetchLoader.options expirationInterval:prefetchLoader.expirationInterval
+						  priority:LoaderRequestPriorityBackground completion:^(NSArray *objects, NSError *error) {
+				// the entry was queued for storing before the completion blocks were called, and the cache answers lookups in order,
+				// so its size reflects what was just loaded
+				if (!error) {
+					weakSelf.cachedBytesUsed += [manager.cache sizeOfObjectsForKey:key];
+				}
+				weakSelf.outstandingRequests--;
+				[weakSelf finishRefreshIfNeeded];
+			}];
+		}
+	}
+
+	[self finishRefreshIfNeeded];
+}
+
+#pragma mark - Private
+
+- (BOOL)hasBudgetRemaining {
+	if (!self.budgetStartDate || -[self.budgetStartDate timeIntervalSinceNow] >= self.budgetInterval) {
+		self.budgetStartDate = [NSDate date];
+		self.cachedBytesUsed = 0;
+	}
+
+	return (self.cacheBudget == 0 || self.cachedBytesUsed < self.cacheBudget);
+}
+
+- (void)finishRefreshIfNeeded {
+	if (self.outstandingRequests > 0 || self.backgroundTask == UIBackgroundTaskInvalid) {
+		return;
+	}
+
+	[[UIApplication sharedApplication] endBackgroundTask:self.backgroundTask];
+	self.backgroundTask = UIBackgroundTaskInvalid;
+}
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification {
+	if (self.backgroundTask != UIBackgroundTaskInvalid) {
+		return;
+	}
+
+	// ask for time to finish the refresh, giving up on any requests still in progress when it runs out
+	__weak typeof(self) weakSelf = self;
+	self.backgroundTask = [[UIApplication sharedApplication] beginBackgroundTaskWithExpirationHandler:^{
+		[[UIApplication sharedApplication] endBackgroundTask:weakSelf.backgroundTask];
+		weakSelf.backgroundTask = UIBackgroundTaskInvalid;
+	}];
+
+	[self refresh];
+}
+
+@end
@@ -0,0 +1,110 @@
+//
+//  RequestMetrics.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class RequestMetrics;
+
+/**
+ *  `RequestMetricsRecord` contains the timing of a single request sent by `LoaderRequestManager`.
+ */
+@interface RequestMetricsRecord : NSObject
+
+@property (nonatomic, copy) NSString *endpoint;
+@property (nonatomic, copy) NSString *key;
+
+/**
+ *  The time, in seconds, between the request being made and sent, which includes any time spent waiting for the batch
+ *  window to close or for visible requests to finish.
+ */
+@property (nonatomic, assign) NSTimeInterval queueDuration;
+
+/**
+ *  The time, in seconds, between the request being sent and the loader returning its mapped objects, including any
+ *  retries. This covers the network transfer as well as the JSON parsing and object mapping done by the loader.
+ */
+@property (nonatomic, assign) NSTimeInterval loadDuration;
+
+/**
+ *  The time, in seconds, spent calling the request's completion blocks.
+ */
+@property (nonatomic, assign) NSTimeInterval dispatchDuration;
+
+@property (nonatomic, assign) NSUInteger retryCount;
+@property (nonatomic, assign) BOOL batched;
+@property (nonatomic, assign) BOOL failed;
+
+/**
+ *  The total time, in seconds, from the request being made until all of its completion blocks were called.
+ */
+- (NSTimeInterval)totalDuration;
+
+@end
+
+
+@protocol RequestMetricsDelegate <NSObject>
+
+/**
+ *  Called on the main thread each time a request's timing is recorded.
+ */
+- (void)requestMetrics:(RequestMetrics *)metrics didRecord:(RequestMetricsRecord *)record;
+
+@end
+
+
+/**
+ *  `RequestMetrics` collects the timing records of the requests sent by `LoaderRequestManager` along with the number of
+ *  requests served from the cache, and summarizes them per endpoint.
+ *
+ *  All methods must be called from the main thread.
+ */
+@interface RequestMetrics : NSObject
+
+@property (nonatomic, weak) id<RequestMetricsDelegate> delegate;
+
+/**
+ *  The number of most recent records kept for each endpoint when calculating percentiles. Defaults to `500`.
+ */
+@property (nonatomic, assign) NSUInteger maximumRecordsPerEndpoint;
+
+/**
+ *  The time, in seconds, from the metrics being created until the first successful request or cache hit was recorded, or
+ *  `0` if none has been recorded yet. Creating the metrics right before `AerisEngine` is set up measures the cold start
+ *  time until the first mapped objects were delivered.
+ */
+@property (readonly, nonatomic) NSTimeInterval firstObjectsDuration;
+
+- (void)addRecord:(RequestMetricsRecord *)record;
+- (void)addCacheHitForEndpoint:(NSString *)endpoint;
+
+/**
+ *  Returns the endpoints that have any recorded requests or cache hits.
+ */
+- (NSArray *)endpoints;
+
+/**
+ *  Returns the total duration, in seconds, at a percentile of the requests recorded for an endpoint.
+ *
+ *  @param percentile The percentile between `0` and `1`, e.g. `0.95`.
+ *  @param endpoint   The API endpoint, e.g. `observations`.
+ */
+- (NSTimeInterval)durationAtPercentile:(double)percentile forEndpoint:(NSString *)endpoint;
+
+/**
+ *  Returns the fraction of lookups for an endpoint that were served from the cache instead of sending a request.
+ */
+- (double)cacheHitRatioForEndpoint:(NSString *)endpoint;
+
+/**
+ *  Logs the first objects duration along with the request count, p50/p95/p99 durations and cache hit ratio for every endpoint.
+ */
+- (void)logSummary;
+
+- (void)reset;
+
+@end
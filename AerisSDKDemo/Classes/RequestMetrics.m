@@ -0,0 +1,140 @@
+//
+//  RequestMetrics.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "RequestMetrics.h"
+
+@implementation RequestMetricsRecord
+
+- (NSTimeInterval)totalDuration {
+	return self.queueDuration + self.loadDuration + self.dispatchDuration;
+}
+
+@end
+
+
+@interface RequestMetrics ()
+@property (nonatomic, strong) NSMutableDictionary *records;
+@property (nonatomic, strong) NSMutableDictionary *requestCounts;
+@property (nonatomic, strong) NSMutableDictionary *cacheHitCounts;
+@property (nonatomic, assign) CFAbsoluteTime createdTime;
+@property (nonatomic, assign) NSTimeInterval firstObjectsDuration;
+- (void)recordFirstObjectsIfNeeded;
+@end
+
+static NSUInteger defaultMaximumRecordsPerEndpoint = 500;
+
+@implementation RequestMetrics
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_records = [[NSMutableDictionary alloc] init];
+		_requestCounts = [[NSMutableDictionary alloc] init];
+		_cacheHitCounts = [[NSMutableDictionary alloc] init];
+		_maximumRecordsPerEndpoint = defaultMaximumRecordsPerEndpoint;
+		_createdTime = CFAbsoluteTimeGetCurrent();
+	}
+	return self;
+}
+
+- (void)addRecord:(RequestMetricsRecord *)record {
+	if (!record.endpoint) {
+		return;
+	}
+
+	NSMutableArray *records = [self.records objectForKey:record.endpoint];
+	if (!records) {
+		records = [[NSMutableArray alloc] init];
+		[self.records setObject:records forKey:record.endpoint];
+	}
+	[records addObject:record];
+
+	// only keep the most recent records so memory use stays bounded during long sessions
+	if ([records count] > self.maximumRecordsPerEndpoint) {
+		[records removeObjectsInRange:NSMakeRange(0, [records count] - self.maximumRecordsPerEndpoint)];
+	}
+
+	NSUInteger count = [[self.requestCounts objectForKey:record.endpoint] unsignedIntegerValue] + 1;
+	[self.requestCounts setObject:@(count) forKey:record.endpoint];
+
+	if (!record.failed) {
+		[self recordFirstObjectsIfNeeded];
+	}
+
+	[self.delegate requestMetrics:self didRecord:record];
+}
+
+- (void)addCacheHitForEndpoint:(NSString *)endpoint {
+	if (!endpoint) {
+		return;
+	}
+
+	NSUInteger count = [[self.cacheHitCounts objectForKey:endpoint] unsignedIntegerValue] + 1;
+	[self.cacheHitCounts setObject:@(count) forKey:endpoint];
+
+	[self recordFirstObjectsIfNeeded];
+}
+
+- (NSArray *)endpoints {
+	NSMutableSet *endpoints = [NSMutableSet setWithArray:[self.requestCounts allKeys]];
+	[endpoints addObjectsFromArray:[self.cacheHitCounts allKeys]];
+
+	return [[endpoints allObjects] sortedArrayUsingSelector:@selector(compare:)];
+}
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile forEndpoint:(NSString *)endpoint {
+	NSArray *records = [self.records objectForKey:endpoint];
+	if ([records count] == 0) {
+		return 0;
+	}
+
+	NSArray *durations = [[records valueForKey:@"totalDuration"] sortedArrayUsingSelector:@selector(compare:)];
+	NSUInteger index = (NSUInteger)ceil(MIN(MAX(percentile, 0), 1) * [durations count]);
+	index = (index > 0) ? index - 1 : 0;
+
+	return [[durations objectAtIndex:index] doubleValue];
+}
+
+- (double)cacheHitRatioForEndpoint:(NSString *)endpoint {
+	NSUInteger hits = [[self.cacheHitCounts objectForKey:endpoint] unsignedIntegerValue];
+	NSUInteger requests = [[self.requestCounts objectForKey:endpoint] unsignedIntegerValue];
+
+	return (hits + requests > 0) ? (double)hits / (hits + requests) : 0;
+}
+
+- (void)logSummary {
+	if (self.firstObjectsDuration > 0) {
+		AppLogInfo(@"first objects after %.0fms", self.firstObjectsDuration * 1000);
+	}
+
+	[[self endpoints] enumerateObjectsUsingBlock:^(NSString *endpoint, NSUInteger idx, BOOL *stop) {
+		AppLogInfo(@"%@: %lu requests, p50 %.0fms, p95 %.0fms, p99 %.0fms, cache hit ratio %.0f%%",
+			  endpoint,
+			  (unsigned long)[[self.requestCounts objectForKey:endpoint] unsignedIntegerValue],
+			  [self durationAtPercentile:0.5 forEndpoint:endpoint] * 1000,
+			  [self durationAtPercentile:0.95 forEndpoint:endpoint] * 1000,
+			  [self durationAtPercentile:0.99 forEndpoint:endpoint] * 1000,
+			  [self cacheHitRatioForEndpoint:endpoint] * 100);
+	}];
+}
+
+- (void)reset {
+	[self.records removeAllObjects];
+	[self.requestCounts removeAllObjects];
+	[self.cacheHitCounts removeAllObjects];
+}
+
+#pragma mark - Private
+
+- (void)recordFirstObjectsIfNeeded {
+	if (self.firstObjectsDuration == 0) {
+		self.firstObjectsDuration = CFAbsoluteTimeGetCurrent() - self.createdTime;
+	}
+}
+
+@end
@@ -0,0 +1,118 @@
+//
+//  ResponseCache.h
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `ResponseCache` is an on-disk store for the mapped objects returned by object loaders. Entries are keyed by the
+ *  canonical request key from `LoaderRequestManager`, expire based on the interval they were stored with or a per-endpoint
+ *  override, and are evicted in least-recently-used order once the cache grows beyond `maximumSize`.
+ *
+ *  Unlike the shared `NSURLCache`, the contents of this cache persist between launches and are only ever removed by the
+ *  cache itself, so cached data can be served without the network on the next launch. The index of entries from the
+ *  previous launch is restored in the background, and lookups made before it has finished wait for it.
+ */
+@interface ResponseCache : NSObject
+
+/**
+ *  The maximum size, in bytes, of all cached entries on disk. Defaults to 10 MB.
+ */
+@property (nonatomic, assign) unsigned long long maximumSize;
+
+/**
+ *  The current size, in bytes, of all cached entries on disk.
+ */
+@property (readonly, nonatomic) unsigned long long currentSize;
+
+/**
+ *  The number of lookups that returned cached objects.
+ */
+@property (readonly, nonatomic) NSUInteger hitCount;
+
+/**
+ *  The number of lookups that found no entry or only an expired entry.
+ */
+@property (readonly, nonatomic) NSUInteger missCount;
+
++ (ResponseCache *)sharedCache;
+
+/**
+ *  Initializes and returns a cache that stores its entries in the specified directory.
+ *
+ *  @param path The directory to store cached entries in, which is created if needed.
+ */
+- (instancetype)initWithDirectoryPath:(NSString *)path;
+
+/**
+ *  Sets the expiration interval to use for all entries stored for an endpoint, overriding the interval provided when the
+ *  entry is stored.
+ *
+ *  @param expirationInterval The duration, in seconds, before entries for the endpoint expire.
+ *  @param endpoint           The API endpoint, e.g. `observations`.
+ */
+- (void)setExpirationInterval:(NSTimeInterval)expirationInterval forEndpoint:(NSString *)endpoint;
+
+/**
+ *  Returns the cached objects for a request key, or `nil` if there is no entry or the entry has expired.
+ */
+- (NSArray *)objectsForKey:(NSString *)key;
+
+/**
+ *  Returns the cached objects for a request key, optionally including an expired entry.
+ *
+ *  @param key              The canonical request key.
+ *  @param includingExpired Whether or not to return the objects from an expired entry.
+ *  @param expired          On return, whether or not the returned objects have expired. May be `NULL`.
+ */
+- (NSArray *)objectsForKey:(NSString *)key includingExpired:(BOOL)includingExpired expired:(BOOL *)expired;
+
+/**
+ *  Returns a digest of the archived objects stored for a request key, or `nil` if there is no entry. Two entries with the
+ *  same digest contain the same data.
+ */
+- (NSString *)digestForKey:(NSString *)key;
+
+/**
+ *  Looks up the digest for a request key in the background, once any entries stored before this is called have been
+ *  written, then calls the block on the main queue with the digest, or `nil` if there is no entry. The calling thread
+ *  doesn't wait for either.
+ */
+- (void)digestForKey:(NSString *)key completion:(void (^)(NSString *digest))completionBlock;
+
+/**
+ *  Returns the date the entry for a request key was stored, or `nil` if there is no entry or it was stored by a version of
+ *  the cache that didn't record it.
+ */
+- (NSDate *)storedDateForKey:(NSString *)key;
+
+/**
+ *  Returns whether or not unexpired objects are cached for the request key. This does not affect the hit and miss counts.
+ */
+- (BOOL)hasObjectsForKey:(NSString *)key;
+
+/**
+ *  Returns the size, in bytes, of the entry stored for a request key, or `0` if there is no entry. Since entries are
+ *  written in the order they're stored, this includes any entry stored before this method was called.
+ */
+- (unsigned long long)sizeOfObjectsForKey:(NSString *)key;
+
+/**
+ *  Stores the objects for a request key. The objects are serialized and written in the background, so they must not be
+ *  modified afterwards, but any lookups made after this returns will find them.
+ *
+ *  @param objects            The mapped objects to store, which are serialized with `CompactObjectSerializer`.
+ *  @param key                The canonical request key.
+ *  @param endpoint           The API endpoint the objects were loaded from.
+ *  @param expirationInterval The duration, in seconds, before the entry expires unless overridden for the endpoint.
+ */
+- (void)setObjects:(NSArray *)objects forKey:(NSString *)key endpoint:(NSString *)endpoint expirationInterval:(NSTimeInterval)expirationInterval;
+
+- (void)removeObjectsForKey:(NSString *)key;
+- (void)removeAllObjects;
+
+@end
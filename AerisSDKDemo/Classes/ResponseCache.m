@@ -0,0 +1,308 @@
+//
+//  ResponseCache.m
+//  AerisCatalog
+//
+//  Created by Nicholas Shipes on 10/16/14.
+//  Copyright (c) 2014 HAMweather, LLC. All rights reserved.
+//
+
+#import "ResponseCache.h"
+#import "CompactObjectSerializer.h"
+
+@interface ResponseCache ()
+@property (nonatomic, copy) NSString *directoryPath;
+@property (nonatomic, strong) NSMutableDictionary *entries;
+@property (nonatomic, strong) NSMutableDictionary *endpointExpirationIntervals;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, assign) unsigned long long size;
+@property (nonatomic, assign) NSUInteger hits;
+@property (nonatomic, assign) NSUInteger misses;
+- (NSString *)fileNameForKey:(NSString *)key;
+- (NSString *)indexPath;
+- (void)saveIndex;
+- (void)removeEntryForKey:(NSString *)key;
+- (void)evictIfNeeded;
+@end
+
+static NSString *indexFileName = @"index.plist";
+
+static NSString *entryFileKey		= @"file";
+static NSString *entrySizeKey		= @"size";
+static NSString *entryEndpointKey	= @"endpoint";
+static NSString *entryExpiresKey	= @"expires";
+static NSString *entryAccessedKey	= @"accessed";
+static NSString *entryDigestKey		= @"digest";
+static NSString *entryStoredKey		= @"stored";
+
+static unsigned long long defaultMaximumSize = 10 * 1024 * 1024;
+
+@implementation ResponseCache
+
++ (ResponseCache *)sharedCache {
+	static ResponseCache *_sharedCache = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSString *cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+		_sharedCache = [[ResponseCache alloc] initWithDirectoryPath:[cachesPath stringByAppendingPathComponent:@"ResponseCache"]];
+	});
+
+	return _sharedCache;
+}
+
+#pragma mark - Instance Methods
+
+- (instancetype)initWithDirectoryPath:(NSString *)path {
+	self = [super init];
+	if (self) {
+		_directoryPath = [path copy];
+		_maximumSize = defaultMaximumSize;
+		_endpointExpirationIntervals = [[NSMutableDictionary alloc] init];
+		_queue = dispatch_queue_create("com.hamweather.aeriscatalog.responsecache", DISPATCH_QUEUE_SERIAL);
+
+		[[NSFileManager defaultManager] createDirectoryAtPath:path withIntermediateDirectories:YES attributes:nil error:nil];
+
+		// restore the index from the previous launch on the cache's queue, which any early lookups wait for. Only the index
+		// itself is read so this stays quick, and entries whose files have gone missing are dropped when they're looked up.
+		_entries = [[NSMutableDictionary alloc] init];
+		dispatch_async(_queue, ^{
+			NSDictionary *index = [NSDictionary dictionaryWithContentsOfFile:[self indexPath]];
+			[index enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSDictionary *entry, BOOL *stop) {
+				[self.entries setObject:[entry mutableCopy] forKey:key];
+				self.size += [[entry objectForKey:entrySizeKey] unsignedLongLongValue];
+			}];
+		});
+	}
+	return self;
+}
+
+- (unsigned long long)currentSize {
+	__block unsigned long long size = 0;
+	dispatch_sync(self.queue, ^{
+		size = self.size;
+	});
+	return size;
+}
+
+- (NSUInteger)hitCount {
+	__block NSUInteger count = 0;
+	dispatch_sync(self.queue, ^{
+		count = self.hits;
+	});
+	return count;
+}
+
+- (NSUInteger)missCount {
+	__block NSUInteger count = 0;
+	dispatch_sync(self.queue, ^{
+		count = self.misses;
+	});
+	return count;
+}
+
+- (void)setMaximumSize:(unsigned long long)maximumSize {
+	dispatch_sync(self.queue, ^{
+		_maximumSize = maximumSize;
+		[self evictIfNeeded];
+	});
+}
+
+- (void)setExpirationInterval:(NSTimeInterval)expirationInterval forEndpoint:(NSString *)endpoint {
+	dispatch_sync(self.queue, ^{
+		[self.endpointExpirationIntervals setObject:@(expirationInterval) forKey:endpoint];
+	});
+}
+
+- (NSArray *)objectsForKey:(NSString *)key {
+	return [self objectsForKey:key includingExpired:NO expired:NULL];
+}
+
+- (NSArray *)objectsForKey:(NSString *)key includingExpired:(BOOL)includingExpired expired:(BOOL *)expired {
+	__block NSData *data = nil;
+	__block BOOL isExpired = NO;
+	dispatch_sync(self.queue, ^{
+		NSMutableDictionary *entry = [self.entries objectForKey:key];
+		isExpired = ([[entry objectForKey:entryExpiresKey] timeIntervalSinceNow] <= 0);
+
+		// expired entries still count as misses even when their objects are returned
+		if (!entry || isExpired) {
+			self.misses++;
+		}
+		if (!entry || (isExpired && !includingExpired)) {
+			return;
+		}
+
+		data = [NSData dataWithContentsOfFile:[self.directoryPath stringByAppendingPathComponent:[entry objectForKey:entryFileKey]]];
+		if (!data) {
+			[self removeEntryForKey:key];
+			return;
+		}
+
+		[entry setObject:[NSDate date] forKey:entryAccessedKey];
+		if (!isExpired) {
+			self.hits++;
+		}
+	});
+
+	if (expired) {
+		*expired = isExpired;
+	}
+
+	if (!data) {
+		return nil;
+	}
+
+	// entries stored before the compact format was introduced are keyed archives
+	NSArray *objects = [CompactObjectSerializer objectsWithData:data];
+	if (!objects) {
+		@try {
+			objects = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+		}
+		@catch (NSException *exception) {
+			[self removeObjectsForKey:key];
+		}
+	}
+
+	return objects;
+}
+
+- (NSString *)digestForKey:(NSString *)key {
+	__block NSString *digest = nil;
+	dispatch_sync(self.queue, ^{
+		digest = [[self.entries objectForKey:key] objectForKey:entryDigestKey];
+	});
+	return digest;
+}
+
+- (void)digestForKey:(NSString *)key completion:(void (^)(NSString *digest))completionBlock {
+	dispatch_async(self.queue, ^{
+		NSString *digest = [[self.entries objectForKey:key] objectForKey:entryDigestKey];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			completionBlock(digest);
+		});
+	});
+}
+
+- (NSDate *)storedDateForKey:(NSString *)key {
+	__block NSDate *storedDate = nil;
+	dispatch_sync(self.queue, ^{
+		storedDate = [[self.entries objectForKey:key] objectForKey:entryStoredKey];
+	});
+	return storedDate;
+}
+
+- (BOOL)hasObjectsForKey:(NSString *)key {
+	__block BOOL exists = NO;
+	dispatch_sync(self.queue, ^{
+		NSDate *expires = [[self.entries objectForKey:key] objectForKey:entryExpiresKey];
+		exists = (expires && [expires timeIntervalSinceNow] > 0);
+	});
+	return exists;
+}
+
+- (unsigned long long)sizeOfObjectsForKey:(NSString *)key {
+	__block unsigned long long size = 0;
+	dispatch_sync(self.queue, ^{
+		size = [[[self.entries objectForKey:key] objectForKey:entrySizeKey] unsignedLongLongValue];
+	});
+	return size;
+}
+
+- (void)setObjects:(NSArray *)objects forKey:(NSString *)key endpoint:(NSString *)endpoint expirationInterval:(NSTimeInterval)expirationInterval {
+	// serialize on the cache's queue rather than the caller's, which is usually the main thread, and before any later
+	// lookups of the same key so they never see the previous entry
+	dispatch_async(self.queue, ^{
+		NSData *data = [CompactObjectSerializer dataWithObjects:objects];
+		if (!data) {
+			return;
+		}
+
+		NSNumber *endpointInterval = [self.endpointExpirationIntervals objectForKey:endpoint];
+		NSTimeInterval interval = (endpointInterval) ? [endpointInterval doubleValue] : expirationInterval;
+
+		NSString *fileName = [self fileNameForKey:key];
+		if (![data writeToFile:[self.directoryPath stringByAppendingPathComponent:fileName] atomically:YES]) {
+			return;
+		}
+
+		// replace any existing entry so its size isn't counted twice
+		NSMutableDictionary *existing = [self.entries objectForKey:key];
+		if (existing) {
+			self.size -= [[existing objectForKey:entrySizeKey] unsignedLongLongValue];
+		}
+
+		NSDate *now = [NSDate date];
+		NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithDictionary:@{entryFileKey: fileName,
+																					 entrySizeKey: @([data length]),
+																					 entryEndpointKey: (endpoint) ? endpoint : @"",
+																					 entryExpiresKey: [now dateByAddingTimeInterval:interval],
+																					 entryAccessedKey: now,
+																					 entryStoredKey: now,
+																					 entryDigestKey: AWFDemoSHA1String(data)}];
+		[self.entries setObject:entry forKey:key];
+		self.size += [data length];
+
+		[self evictIfNeeded];
+		[self saveIndex];
+	});
+}
+
+- (void)removeObjectsForKey:(NSString *)key {
+	dispatch_async(self.queue, ^{
+		[self removeEntryForKey:key];
+		[self saveIndex];
+	});
+}
+
+- (void)removeAllObjects {
+	dispatch_async(self.queue, ^{
+		[[self.entries allKeys] enumerateObjectsUsingBlock:^(NSString *key, NSUInteger idx, BOOL *stop) {
+			[self removeEntryForKey:key];
+		}];
+		[self saveIndex];
+	});
+}
+
+#pragma mark - Private
+
+- (NSString *)fileNameForKey:(NSString *)key {
+	return AWFDemoSHA1String([key dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+- (NSString *)indexPath {
+	return [self.directoryPath stringByAppendingPathComponent:indexFileName];
+}
+
+- (void)saveIndex {
+	[self.entries writeToFile:[self indexPath] atomically:YES];
+}
+
+- (void)removeEntryForKey:(NSString *)key {
+	NSDictionary *entry = [self.entries objectForKey:key];
+	if (!entry) {
+		return;
+	}
+
+	[[NSFileManager defaultManager] removeItemAtPath:[self.directoryPath stringByAppendingPathComponent:[entry objectForKey:entryFileKey]] error:nil];
+	self.size -= [[entry objectForKey:entrySizeKey] unsignedLongLongValue];
+	[self.entries removeObjectForKey:key];
+}
+
+- (void)evictIfNeeded {
+	if (self.size <= _maximumSize) {
+		return;
+	}
+
+	// remove the least recently accessed entries until we're back under the size limit
+	NSArray *keys = [self.entries keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+		return [[entry1 objectForKey:entryAccessedKey] compare:[entry2 objectForKey:entryAccessedKey]];
+	}];
+
+	for (NSString *key in keys) {
+		if (self.size <= _maximumSize) {
+			break;
+		}
+		[self removeEntryForKey:key];
+	}
+}
+
+@end
@@ -9,6 +9,7 @@
 #import "DetailedWeatherViewController_iPad.h"
 #import "LocationSearchViewController.h"
 #import "CatalogViewController.h"
+#import "DateFormatterCache.h"
 
 @interface DetailedWeatherViewController_iPad ()
 @property (nonatomic, strong) AWFObservationView *obsView;
@@ -24,6 +25,8 @@
 
 static NSString *forecastCellIdentifier = @"ForecastCellIdentifier";
 static CGFloat cellHeight = 122.0f;
+static NSTimeInterval observationsExpirationInterval = 300;
+static NSTimeInterval forecastsExpirationInterval = 1800;
 
 @implementation DetailedWeatherViewController_iPad
 
@@ -128,9 +131,9 @@ static CGFloat cellHeight = 122.0f;
 	
 	// load latest observation data for place
 	__weak typeof(self.obsView) weakObsView = self.obsView;
-	[self.obsLoader getObservationForPlace:place options:nil completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.obsLoader place:place options:nil expirationInterval:observationsExpirationInterval completion:^(NSArray *objects, NSError *error) {
 		if (error) {
-			NSLog(@"Observation data failed to load! %@", error);
+			AppLogError(@"Observation data failed to load! %@", error);
 			return;
 		}
 		
@@ -155,14 +158,14 @@ static CGFloat cellHeight = 122.0f;
 		}
 	}];
 	
-	// load 24-hour forecast
+	// load 24-hour forecast, showing the last cached forecast right away if it has expired
 	AWFRequestOptions *forecastOptions = [[AWFRequestOptions alloc] init];
 	forecastOptions.limit = 28;
 	forecastOptions.filterString = @"daynight";
 	
-	[self.forecastsLoader getForecastForPlace:place options:forecastOptions completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.forecastsLoader place:place options:forecastOptions expirationInterval:forecastsExpirationInterval staleCompletion:^(NSArray *objects, BOOL isStale, NSError *error) {
 		if (error) {
-			NSLog(@"Forecast data failed to load!: %@", error);
+			AppLogError(@"Forecast data failed to load!: %@", error);
 			return;
 		}
 		
@@ -173,14 +176,14 @@ static CGFloat cellHeight = 122.0f;
 		}
 	}];
 	
-	// load hourly forecast
+	// load hourly forecast, showing the last cached forecast right away if it has expired
 	AWFRequestOptions *hourlyOptions = [[AWFRequestOptions alloc] init];
 	hourlyOptions.limit = 9;
 	hourlyOptions.filterString = @"3hr";
 	
-	[self.forecastsLoader getForecastForPlace:place options:hourlyOptions completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.forecastsLoader place:place options:hourlyOptions expirationInterval:forecastsExpirationInterval staleCompletion:^(NSArray *objects, BOOL isStale, NSError *error) {
 		if (error) {
-			NSLog(@"Hourly forecast data failed to load!: %@", error);
+			AppLogError(@"Hourly forecast data failed to load!: %@", error);
 			return;
 		}
 		
@@ -194,7 +197,7 @@ static CGFloat cellHeight = 122.0f;
 	// load advisories
 	[self.advisoriesLoader getAdvisoriesForPlace:place options:nil completion:^(NSArray *objects, NSError *error) {
 		if (error) {
-			NSLog(@"Advisories data failed to load! %@", error);
+			AppLogError(@"Advisories data failed to load! %@", error);
 			return;
 		}
 		
@@ -237,8 +240,8 @@ static CGFloat cellHeight = 122.0f;
 		nightPeriod = (AWFForecastPeriod *)[self.forecastPeriods objectAtIndex:dayIndex];
 	}
 	
-	cell.weatherView.periodLabel.text = [dayPeriod.timestamp awf_stringWithFormat:@"eeee"];
-	cell.weatherView.dateLabel.text = [dayPeriod.timestamp awf_stringWithFormat:@"MMM d"];
+	cell.weatherView.periodLabel.text = [DateFormatterCache stringFromDate:dayPeriod.timestamp format:@"eeee" timeZone:dayPeriod.timeZone];
+	cell.weatherView.dateLabel.text = [DateFormatterCache stringFromDate:dayPeriod.timestamp format:@"MMM d" timeZone:dayPeriod.timeZone];
 	[self updateForecastView:cell.weatherView.firstPeriodView withPeriod:dayPeriod];
 	[self updateForecastView:cell.weatherView.secondPeriodView withPeriod:nightPeriod];
 	
@@ -52,7 +52,7 @@
 	[self.eventView showLoading];
 	[self.loader getAdvisoriesForPlace:place options:nil completion:^(NSArray *objects, NSError *error) {
 		if (error) {
-			NSLog(@"Advisories data failed to load! %@", error);
+			AppLogError(@"Advisories data failed to load! %@", error);
 			[weakSelf.eventView showMessage:NSLocalizedString(@"An error occurred during the request.", nil)];
 			return;
 		}
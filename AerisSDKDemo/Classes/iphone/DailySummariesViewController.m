@@ -8,6 +8,7 @@
 
 #import "DailySummariesViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface DailySummariesViewController ()
 @property (nonatomic, strong) UICollectionView *collectionView;
@@ -103,10 +104,8 @@ static CGFloat cellHeight = 217.0f;
 
 		AWFObservationSummaryPeriod *period = (AWFObservationSummaryPeriod *)self.summary.periods[indexPath.row];
 
-		[NSDate awf_setDefaultTimezone:self.summary.place.timeZone];
-
 		NSString *dateFormat = [NSString stringWithFormat:@"%@, %@ %@", AWFDateFormatDayName, AWFDateFormatMonthName, AWFDateFormatDate];
-		summaryCell.weatherView.headerView.textLabel.text = [period.timestamp awf_stringWithFormat:dateFormat];
+		summaryCell.weatherView.headerView.textLabel.text = [DateFormatterCache stringFromDate:period.timestamp format:dateFormat timeZone:self.summary.place.timeZone];
 
 		summaryCell.weatherView.weatherTextLabel.text = [period.weather capitalizedString];
 		summaryCell.weatherView.iconImageView.image = [AWFImage weatherIconNamed:period.icon];
@@ -160,7 +159,7 @@ static CGFloat cellHeight = 217.0f;
 	[self.obsLoader getObservationSummaryForPlace:place fromDate:fromDate toDate:nil options:options completion:^(NSArray *objects, NSError *error) {
 	    if (error) {
 	        [self.eventView showMessage:NSLocalizedString(@"An error occurred while requesting the weather data.", nil)];
-	        NSLog(@"Daily summaries failed to load! %@", error.localizedDescription);
+	        AppLogError(@"Daily summaries failed to load! %@", error.localizedDescription);
 
 	        return;
 		}
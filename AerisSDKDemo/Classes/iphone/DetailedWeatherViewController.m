@@ -8,6 +8,7 @@
 
 #import "DetailedWeatherViewController.h"
 #import "AdvisoriesViewController.h"
+#import "DateFormatterCache.h"
 
 @interface DetailedWeatherViewController ()
 @property (nonatomic, strong) AWFObservationView *obsView;
@@ -24,6 +25,8 @@
 @end
 
 static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
+static NSTimeInterval observationsExpirationInterval = 300;
+static NSTimeInterval forecastsExpirationInterval = 1800;
 
 @implementation DetailedWeatherViewController
 
@@ -136,6 +139,10 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 	[super viewWillDisappear:animated];
 	
 	[[NSNotificationCenter defaultCenter] removeObserver:self name:UIApplicationDidBecomeActiveNotification object:nil];
+	
+	// data is reloaded when the view appears again, so don't let requests for it hold up the next screen
+	[[LoaderRequestManager sharedManager] cancelRequestsForLoader:self.obsLoader];
+	[[LoaderRequestManager sharedManager] cancelRequestsForLoader:self.forecastsLoader];
 }
 
 - (void)showAdvisories {
@@ -164,9 +171,7 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 		
 		AWFForecastPeriod *period = (AWFForecastPeriod *)[self.hourlyPeriods objectAtIndex:indexPath.row];
 		
-		// need to set the proper default timezone to use when formatting this location's date/time/day
-		[NSDate awf_setDefaultTimezone:period.timeZone];
-		hourlyCell.weatherView.period = [period.timestamp awf_stringWithFormat:@"h a"];
+		hourlyCell.weatherView.period = [DateFormatterCache stringFromDate:period.timestamp format:@"h a" timeZone:period.timeZone];
 		
 		hourlyCell.weatherView.temp = [NSString stringWithFormat:@"%i", [period.tempF intValue]];
 		hourlyCell.weatherView.pop = [NSString stringWithFormat:@"%i%%", [period.pop integerValue]];
@@ -195,9 +200,9 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 	
 	// load latest observation data for place
 	__weak typeof(self.obsView) weakObsView = self.obsView;
-	[self.obsLoader getObservationForPlace:place options:nil completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.obsLoader place:place options:nil expirationInterval:observationsExpirationInterval completion:^(NSArray *objects, NSError *error) {
 		if (error) {
-			NSLog(@"Observation data failed to load! %@", error);
+			AppLogError(@"Observation data failed to load! %@", error);
 			return;
 		}
 		
@@ -222,14 +227,14 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 		}
 	}];
 	
-	// load 24-hour forecast
+	// load 24-hour forecast, showing the last cached forecast right away if it has expired
 	AWFRequestOptions *forecastOptions = [[AWFRequestOptions alloc] init];
 	forecastOptions.limit = 2;
 	forecastOptions.filterString = @"daynight";
 	
-	[self.forecastsLoader getForecastForPlace:place options:forecastOptions completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.forecastsLoader place:place options:forecastOptions expirationInterval:forecastsExpirationInterval staleCompletion:^(NSArray *objects, BOOL isStale, NSError *error) {
 		if (error) {
-			NSLog(@"24-hour forecast data failed to load! %@", error);
+			AppLogError(@"24-hour forecast data failed to load! %@", error);
 			return;
 		}
 		
@@ -266,14 +271,14 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 		}
 	}];
 	
-	// load hourly forecast
+	// load hourly forecast, showing the last cached forecast right away if it has expired
 	AWFRequestOptions *hourlyOptions = [[AWFRequestOptions alloc] init];
 	hourlyOptions.limit = 9;
 	hourlyOptions.filterString = @"3hr";
 	
-	[self.forecastsLoader getForecastForPlace:place options:hourlyOptions completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getWithLoader:self.forecastsLoader place:place options:hourlyOptions expirationInterval:forecastsExpirationInterval staleCompletion:^(NSArray *objects, BOOL isStale, NSError *error) {
 		if (error) {
-			NSLog(@"Hourly forecast data failed to load!: %@", error);
+			AppLogError(@"Hourly forecast data failed to load!: %@", error);
 			return;
 		}
 		
@@ -287,7 +292,7 @@ static NSString *hourlyCellIdentifier = @"HourlyForecastCell";
 	// load advisories
 	[self.advisoriesLoader getAdvisoriesForPlace:place options:nil completion:^(NSArray *objects, NSError *error) {
 		if (error) {
-			NSLog(@"Advisories data failed to load! %@", error);
+			AppLogError(@"Advisories data failed to load! %@", error);
 			return;
 		}
 		
@@ -9,6 +9,7 @@
 #import "EarthquakesViewController.h"
 #import "ListingEventView.h"
 #import "ListingTableViewCell.h"
+#import "DateFormatterCache.h"
 
 @interface EarthquakesViewController ()
 @property (nonatomic, strong) AWFEarthquakesLoader *loader;
@@ -50,9 +51,6 @@
 - (void)handleConfigurationOfCell:(UITableViewCell *)cell forIndexPath:(NSIndexPath *)indexPath {
 	AWFEarthquake *report = (AWFEarthquake *)[self.results objectAtIndex:indexPath.row];
 
-	// set global NSDateFormatter timezone to local time
-	[NSDate awf_setDefaultTimezone:report.place.timeZone];
-
 	NSString *reportType = @"";
 	NSString *typeIcon = @"";
 	if ([report.type isEqualToString:@"mini"]) {
@@ -84,7 +82,7 @@
 		typeIcon = @"quake_major.png";
 	}
 
-	NSString *date = [report.timestamp awf_stringWithFormat:@"M/d/y h:mm a"];
+	NSString *date = [DateFormatterCache stringFromDate:report.timestamp format:@"M/d/y h:mm a" timeZone:report.place.timeZone];
 	cell.textLabel.text = [NSString stringWithFormat:@"%.2f (%@)", [report.magnitude floatValue], reportType];
 	cell.detailTextLabel.text = [NSString stringWithFormat:@"%@ - %@, %@", date, [report.place.name capitalizedString], (([[report.place.country lowercaseString] isEqualToString:@"us"]) ? [report.place.state uppercaseString] : [report.place.country uppercaseString])];
 
@@ -8,6 +8,7 @@
 
 #import "ForecastViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface ForecastViewController ()
 @property (nonatomic, strong) UICollectionView *collectionView;
@@ -86,7 +87,7 @@ static NSString *forecastCellIdentifier = @"ForecastCell";
 	[self.forecastsLoader getForecastForPlace:place options:forecastOptions completion:^(NSArray *objects, NSError *error) {
 		if (error) {
 			[self.eventView showMessage:NSLocalizedString(@"An error occurred while requesting the weather data.", nil)];
-			NSLog(@"Forecast data failed to load! %@", error.localizedDescription);
+			AppLogError(@"Forecast data failed to load! %@", error.localizedDescription);
 			return;
 		}
 		
@@ -122,8 +123,8 @@ static NSString *forecastCellIdentifier = @"ForecastCell";
 		forecastCell.weatherView.lowtemp = [NSString stringWithFormat:@"%i", [period.minTempF intValue]];
 		forecastCell.weatherView.weather = period.weatherFull;
 		forecastCell.weatherView.icon = [AWFImage weatherIconNamed:period.icon];
-		forecastCell.weatherView.day = [period.timestamp awf_stringWithFormat:@"eee"];
-		forecastCell.weatherView.date = [period.timestamp awf_stringWithFormat:@"MMM d"];
+		forecastCell.weatherView.day = [DateFormatterCache stringFromDate:period.timestamp format:@"eee" timeZone:period.timeZone];
+		forecastCell.weatherView.date = [DateFormatterCache stringFromDate:period.timestamp format:@"MMM d" timeZone:period.timeZone];
 	}
 	
 	return cell;
@@ -71,7 +71,7 @@
 
 		[self.loader getIndicesOfType:self.currentIndexType forPlace:place options:options completion:^(NSArray *objects, NSError *error) {
 		    if (error) {
-		        NSLog(@"Listing data failed to load! %@", error);
+		        AppLogError(@"Listing data failed to load! %@", error);
 		        [weakSelf.eventView showMessage:NSLocalizedString(@"An error occurred during the request.", nil)];
 
 		        return;
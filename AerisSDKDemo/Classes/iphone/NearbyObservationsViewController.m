@@ -8,6 +8,7 @@
 
 #import "NearbyObservationsViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface NearbyObservationsViewController ()
 @property (nonatomic, strong) UICollectionView *collectionView;
@@ -85,10 +86,10 @@ static CGFloat cellHeight = 83.0f;
 		[self.eventView showLoading];
 	}
 	
-	[self.obsLoader getClosestToPlace:place radius:@"300mi" options:options completion:^(NSArray *objects, NSError *error) {
+	[[LoaderRequestManager sharedManager] getClosestWithLoader:self.obsLoader place:place radius:@"300mi" options:options completion:^(NSArray *objects, NSError *error) {
 		if (error) {
 			[self.eventView showMessage:NSLocalizedString(@"An error occurred while requesting the weather data.", nil)];
-			NSLog(@"Nearby observations failed to load! %@", error.localizedDescription);
+			AppLogError(@"Nearby observations failed to load! %@", error.localizedDescription);
 			return;
 		}
 		
@@ -101,6 +102,12 @@ static CGFloat cellHeight = 83.0f;
 	}];
 }
 
+- (void)viewWillDisappear:(BOOL)animated {
+	[super viewWillDisappear:animated];
+	
+	[[LoaderRequestManager sharedManager] cancelRequestsForLoader:self.obsLoader];
+}
+
 - (void)viewWillLayoutSubviews {
 	[super viewWillLayoutSubviews];
 	
@@ -127,12 +134,11 @@ static CGFloat cellHeight = 83.0f;
 		
 		AWFObservation *obs = (AWFObservation *)[self.observations objectAtIndex:indexPath.row];
 		
-		[NSDate awf_setDefaultTimezone:obs.place.timeZone];
 		obsCell.weatherView.nameLabel.text = [obs.place.name capitalizedString];
 		obsCell.weatherView.tempTextLabel.text = [NSString stringWithFormat:@"%i", [obs.tempF intValue]];
 		obsCell.weatherView.weatherTextLabel.text = obs.weatherFull;
 		obsCell.weatherView.iconImageView.image = [AWFImage weatherIconNamed:obs.icon];
-		obsCell.weatherView.timeLabel.text = [obs.timestamp awf_stringWithFormat:@"h:mm a"];
+		obsCell.weatherView.timeLabel.text = [DateFormatterCache stringFromDate:obs.timestamp format:@"h:mm a" timeZone:obs.place.timeZone];
 	}
 	
 	return cell;
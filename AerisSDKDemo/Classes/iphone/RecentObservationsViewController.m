@@ -8,6 +8,7 @@
 
 #import "RecentObservationsViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface RecentObservationsViewController ()
 @property (nonatomic, strong) UICollectionView *collectionView;
@@ -87,7 +88,7 @@ static CGFloat cellHeight = 60.0f;
 	[self.obsLoader getRecentObservationsForPlace:place total:20 options:options completion:^(NSArray *objects, NSError *error) {
 		if (error) {
 			[self.eventView showMessage:NSLocalizedString(@"An error occurred while requesting the weather data.", nil)];
-			NSLog(@"Recent observations data failed to load! %@", error.localizedDescription);
+			AppLogError(@"Recent observations data failed to load! %@", error.localizedDescription);
 			return;
 		}
 		
@@ -127,12 +128,11 @@ static CGFloat cellHeight = 60.0f;
 		
 		AWFObservation *obs = (AWFObservation *)[self.observations objectAtIndex:indexPath.row];
 		
-		[NSDate awf_setDefaultTimezone:obs.place.timeZone];
 		obsCell.weatherView.tempTextLabel.text = [NSString stringWithFormat:@"%i", [obs.tempF intValue]];
 		obsCell.weatherView.weatherTextLabel.text = obs.weatherFull;
 		obsCell.weatherView.iconImageView.image = [AWFImage weatherIconNamed:obs.icon];
-		obsCell.weatherView.dayLabel.text = [obs.timestamp awf_stringWithFormat:@"eee"];
-		obsCell.weatherView.timeLabel.text = [obs.timestamp awf_stringWithFormat:@"h:mm a"];
+		obsCell.weatherView.dayLabel.text = [DateFormatterCache stringFromDate:obs.timestamp format:@"eee" timeZone:obs.place.timeZone];
+		obsCell.weatherView.timeLabel.text = [DateFormatterCache stringFromDate:obs.timestamp format:@"h:mm a" timeZone:obs.place.timeZone];
 	}
 	
 	return cell;
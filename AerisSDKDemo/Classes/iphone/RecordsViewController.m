@@ -8,6 +8,7 @@
 
 #import "RecordsViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface RecordsViewController ()
 @property (nonatomic, strong) AWFRecordsLoader *loader;
@@ -48,9 +49,6 @@
 - (void)handleConfigurationOfCell:(UITableViewCell *)cell forIndexPath:(NSIndexPath *)indexPath {
 	AWFRecord *report = (AWFRecord *)[self.results objectAtIndex:indexPath.row];
 	
-	// set global NSDateFormatter timezone to local time
-	[NSDate awf_setDefaultTimezone:report.place.timeZone];
-	
 	NSString *reportType = @"";
 	NSString *val = @"";
 	NSString *typeIcon = @"";
@@ -86,7 +84,7 @@
 		typeIcon = @"report_lowmaxtemp.png";
 	}
 	
-	NSString *date = [report.timestamp awf_stringWithFormat:@"M/d/y"];
+	NSString *date = [DateFormatterCache stringFromDate:report.timestamp format:@"M/d/y" timeZone:report.place.timeZone];
 	cell.textLabel.text = [NSString stringWithFormat:@"%@ - %@%@", [reportType capitalizedString], val, ((report.isTied == YES) ? @"*" : @"")];
     cell.detailTextLabel.text = [NSString stringWithFormat:@"%@ - %@, %@", date, [report.place.name capitalizedString], [report.place.state uppercaseString]];
 	
@@ -40,7 +40,7 @@
 	options.limit = 30;
 	options.fromDateString = @"-24 hours";
 	
-	[self loadDataClosestToPlace:place radius:@"150mi" options:options];
+	[self loadPagedDataClosestToPlace:place radius:@"150mi" options:options];
 }
 
 #pragma mark - ListingViewController
@@ -8,6 +8,7 @@
 
 #import "WeekendWeatherViewController.h"
 #import "ListingEventView.h"
+#import "DateFormatterCache.h"
 
 @interface WeekendWeatherViewController ()
 @property (nonatomic, strong) UICollectionView *collectionView;
@@ -99,7 +100,7 @@ static CGFloat cellHeight = 139.0f;
 	[self.forecastsLoader getForecastForPlace:place options:forecastOptions completion:^(NSArray *objects, NSError *error) {
 		if (error) {
 			[self.eventView showMessage:NSLocalizedString(@"An error occurred while requesting the weather data.", nil)];
-			NSLog(@"Forecast data failed to load! %@", error);
+			AppLogError(@"Forecast data failed to load! %@", error);
 			return;
 		}
 		
@@ -174,15 +175,15 @@ static CGFloat cellHeight = 139.0f;
 			NSDictionary *periods = [self.periods objectForKey:dayKey];
 			if ([periods objectForKey:@"day"]) {
 				AWFForecastPeriod *dayPeriod = (AWFForecastPeriod *)[periods objectForKey:@"day"];
-				forecastCell.weatherView.periodLabel.text = [dayPeriod.timestamp awf_stringWithFormat:@"eeee"];
-				forecastCell.weatherView.dateLabel.text = [dayPeriod.timestamp awf_stringWithFormat:@"MMM d"];
+				forecastCell.weatherView.periodLabel.text = [DateFormatterCache stringFromDate:dayPeriod.timestamp format:@"eeee" timeZone:dayPeriod.timeZone];
+				forecastCell.weatherView.dateLabel.text = [DateFormatterCache stringFromDate:dayPeriod.timestamp format:@"MMM d" timeZone:dayPeriod.timeZone];
 				
 				[self updateForecastView:forecastCell.weatherView.firstPeriodView withPeriod:dayPeriod];
 			}
 			if ([periods objectForKey:@"night"]) {
 				AWFForecastPeriod *nightPeriod = (AWFForecastPeriod *)[periods objectForKey:@"night"];
-				forecastCell.weatherView.periodLabel.text = [nightPeriod.timestamp awf_stringWithFormat:@"eeee"];
-				forecastCell.weatherView.dateLabel.text = [nightPeriod.timestamp awf_stringWithFormat:@"MMM d"];
+				forecastCell.weatherView.periodLabel.text = [DateFormatterCache stringFromDate:nightPeriod.timestamp format:@"eeee" timeZone:nightPeriod.timeZone];
+				forecastCell.weatherView.dateLabel.text = [DateFormatterCache stringFromDate:nightPeriod.timestamp format:@"MMM d" timeZone:nightPeriod.timeZone];
 				
 				[self updateForecastView:forecastCell.weatherView.secondPeriodView withPeriod:nightPeriod];
 			}